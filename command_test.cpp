@@ -0,0 +1,160 @@
+// Bus de commandes : MpscRing sous plusieurs producteurs, puis Engine::pushCommand
+// depuis plusieurs threads jusqu'à l'état vu par process().
+
+#include "drumbox_core/Engine.h"
+#include "drumbox_core/LockFreeRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace drumbox_core;
+
+namespace {
+
+int failures = 0;
+
+// Une file bloquée (commande perdue, process() qui ne vide plus) échoue au lieu de pendre
+using Clock = std::chrono::steady_clock;
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+void expect(bool ok, const char* what)
+{
+    if (!ok)
+    {
+        std::printf("FAIL %s\n", what);
+        ++failures;
+    }
+}
+
+// N producteurs, un consommateur concurrent : tout arrive, dans l'ordre de chaque producteur
+void ringMultiProducer()
+{
+    constexpr int kProducers = 4;
+    constexpr int kItems = 50000;
+
+    struct Item { i32 producer; i32 seq; };
+    MpscRing<Item, 256> ring;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+        producers.emplace_back([&ring, p] {
+            for (int i = 0; i < kItems; ++i)
+                while (!ring.push(Item{ p, i }))
+                    std::this_thread::yield(); // pleine : le consommateur doit avancer
+        });
+
+    int next[kProducers] = {};
+    bool ordered = true;
+    int received = 0;
+    const auto deadline = Clock::now() + kTimeout;
+    while (received < kProducers * kItems && Clock::now() < deadline)
+    {
+        Item it;
+        if (!ring.pop(it))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (it.producer < 0 || it.producer >= kProducers || it.seq != next[it.producer])
+            ordered = false;
+        else
+            ++next[it.producer];
+        ++received;
+    }
+
+    for (auto& t : producers)
+        t.join();
+
+    Item extra;
+    expect(received == kProducers * kItems, "ring: tous les éléments reçus");
+    expect(ordered, "ring: ordre par producteur");
+    expect(!ring.pop(extra), "ring: vide après réception");
+}
+
+// Plusieurs threads éditent la même Engine ; process() applique tout, par bloc.
+void engineCommands()
+{
+    constexpr int kThreads = 4;
+    constexpr int kToggles = 75; // 4 * 4 * 75 = 1200 SetStep > kMaxCommandsPerBlock
+
+    Engine engine;
+    engine.prepare(48000.0, 256);
+    engine.setPlaying(false);
+
+    const ParamInfo* decay = findParam("kickDecay");
+    std::atomic<int> finished{0};
+    std::atomic<int> dropped{0};
+    const auto deadline = Clock::now() + kTimeout;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+        threads.emplace_back([&engine, &finished, &dropped, deadline, decay, t] {
+            auto push = [&](const Command& c) {
+                while (!engine.pushCommand(c)) // pleine : process() doit la vider
+                {
+                    if (Clock::now() > deadline)
+                    {
+                        dropped.fetch_add(1);
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+            };
+
+            // chaque thread possède 4 steps de la lane kick : on/off en boucle, vélocité
+            // croissante ; kToggles impair, le dernier SetStep est on à 1.0
+            for (int k = 0; k < kToggles; ++k)
+                for (int s = t * 4; s < t * 4 + 4; ++s)
+                    push(Command::setStep(0, s, k % 2 == 0, (float)(k + 1) / (float)kToggles));
+
+            if (t == 0)
+                push(Command::setParam(*decay, 0.999f));
+            if (t == 1)
+                push(Command::setBpm(140.0f));
+            if (t == 2)
+                push(Command::trigger(0, 1.0f));
+            finished.fetch_add(1);
+        });
+
+    // le thread audio tourne pendant que les producteurs poussent, puis vide la file
+    std::vector<float> out(256 * 2);
+    float peak = 0.0f;
+    for (int tail = 0; tail < 8;)
+    {
+        if (finished.load() == kThreads)
+            ++tail;
+        engine.process(out.data(), 256, 2);
+        for (float v : out)
+            peak = std::fmax(peak, std::fabs(v));
+        std::this_thread::yield();
+    }
+    for (auto& t : threads)
+        t.join();
+
+    const int pattern = engine.getPatternIndex();
+    bool steps = true;
+    for (int s = 0; s < kThreads * 4; ++s)
+        steps = steps && engine.patterns().isOn(pattern, 0, s)
+                      && engine.patterns().velocity(pattern, 0, s) == 1.0f;
+
+    expect(dropped.load() == 0, "engine: file jamais vidée par process()");
+    expect(steps, "engine: steps (dernier SetStep de chaque thread)");
+    expect(engine.params().kickDecay.load() == 0.999f, "engine: SetParam");
+    expect(engine.getBpm() == 140.0f, "engine: SetBpm");
+    expect(peak > 0.01f, "engine: Trigger rendu");
+}
+
+} // namespace
+
+int main()
+{
+    ringMultiProducer();
+    engineCommands();
+
+    if (failures == 0)
+        std::printf("commandes ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+// Drumbox/core/include/drumbox_core/AllocTrap.h
+
+#pragma once
+
+namespace drumbox_core {
+
+// Piège à allocations (debug) : compilé avec DRUMBOX_ALLOC_TRAP (option CMake),
+// operator new/delete sont remplacés et font abort() s'ils sont appelés sur un thread
+// qui est dans un ScopedAllocTrap (Engine::process). Sans l'option : ne fait rien.
+// Ne voit que new/delete (std::vector, std::function, ...), pas un malloc() direct.
+#if defined(DRUMBOX_ALLOC_TRAP)
+
+namespace alloctrap {
+void enter();
+void leave();
+} // namespace alloctrap
+
+struct ScopedAllocTrap
+{
+    ScopedAllocTrap() { alloctrap::enter(); }
+    ~ScopedAllocTrap() { alloctrap::leave(); }
+
+    ScopedAllocTrap(const ScopedAllocTrap&) = delete;
+    ScopedAllocTrap& operator=(const ScopedAllocTrap&) = delete;
+};
+
+#else
+
+struct ScopedAllocTrap
+{
+    ScopedAllocTrap() {}
+};
+
+#endif
+
+} // namespace drumbox_core
@@ -0,0 +1,110 @@
+// Drumbox/core/include/drumbox_core/Command.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+#include "drumbox_core/Params.h"
+
+namespace drumbox_core {
+
+// Commande typée d'un front end (UI, MIDI, runner...) vers l'Engine.
+// Envoyée par Engine::pushCommand() depuis n'importe quel thread, appliquée par le
+// thread audio au début du process() suivant.
+// frame : offset dans ce bloc. Les triggers sont joués à ce frame (comme pushEvent) ;
+// les changements d'état (steps, patterns, params, transport) s'appliquent au début du bloc.
+struct Command
+{
+    enum Type
+    {
+        SetStep,          // pattern (-1 = courant), lane, step, on, value = vélocité
+        SetPatternLength, // pattern (-1 = courant), index = steps
+        QueuePattern,     // pattern
+        SetSongMode,      // on
+        SetParam,         // index dans kParamInfo, value
+        Trigger,          // frame, lane, value = vélocité
+        SetBpm,           // value
+        SetPlaying        // on
+    };
+
+    Type  type = SetStep;
+    bool  on = false;
+    i32   frame = 0;
+    i32   pattern = -1;
+    i32   lane = 0;
+    i32   step = 0;
+    i32   index = 0;
+    float value = 0.0f;
+
+    static Command setStep(int lane, int step, bool on, float vel = 1.0f, int pattern = -1)
+    {
+        Command c;
+        c.type = SetStep;
+        c.pattern = pattern;
+        c.lane = lane;
+        c.step = step;
+        c.on = on;
+        c.value = vel;
+        return c;
+    }
+
+    static Command setPatternLength(int steps, int pattern = -1)
+    {
+        Command c;
+        c.type = SetPatternLength;
+        c.pattern = pattern;
+        c.index = steps;
+        return c;
+    }
+
+    static Command queuePattern(int pattern)
+    {
+        Command c;
+        c.type = QueuePattern;
+        c.pattern = pattern;
+        return c;
+    }
+
+    static Command setSongMode(bool on)
+    {
+        Command c;
+        c.type = SetSongMode;
+        c.on = on;
+        return c;
+    }
+
+    static Command setParam(const ParamInfo& param, float value)
+    {
+        Command c;
+        c.type = SetParam;
+        c.index = (i32)(&param - kParamInfo);
+        c.value = value;
+        return c;
+    }
+
+    static Command trigger(int lane, float vel, int frame = 0)
+    {
+        Command c;
+        c.type = Trigger;
+        c.lane = lane;
+        c.value = vel;
+        c.frame = frame;
+        return c;
+    }
+
+    static Command setBpm(float bpm)
+    {
+        Command c;
+        c.type = SetBpm;
+        c.value = bpm;
+        return c;
+    }
+
+    static Command setPlaying(bool playing)
+    {
+        Command c;
+        c.type = SetPlaying;
+        c.on = playing;
+        return c;
+    }
+};
+
+} // namespace drumbox_core
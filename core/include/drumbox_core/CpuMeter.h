@@ -0,0 +1,219 @@
+// Drumbox/core/include/drumbox_core/CpuMeter.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+
+#include <atomic>
+#include <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+  #define DRUMBOX_CPU_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define DRUMBOX_CPU_TSC 1
+#elif defined(__aarch64__)
+  #define DRUMBOX_CPU_CNTVCT 1
+#endif
+
+namespace drumbox_core {
+
+// Compteur de cycles : TSC (x86), compteur virtuel (ARM64), sinon steady_clock en ns.
+// Quelques cycles par lecture : utilisable plusieurs fois par sous-bloc.
+inline u64 cpuTicks()
+{
+#if defined(DRUMBOX_CPU_TSC)
+    return (u64)__rdtsc();
+#elif defined(DRUMBOX_CPU_CNTVCT)
+    u64 v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Fréquence de cpuTicks(). Calibrée une fois (quelques ms d'attente active) :
+// à appeler hors thread audio la première fois (CpuMeter::prepare).
+inline double cpuTicksPerSecond()
+{
+    static const double rate = [] {
+#if defined(DRUMBOX_CPU_TSC)
+        using Clock = std::chrono::steady_clock;
+        const auto t0 = Clock::now();
+        const u64 c0 = cpuTicks();
+        auto t1 = t0;
+        while (t1 - t0 < std::chrono::milliseconds(5))
+            t1 = Clock::now();
+        const u64 c1 = cpuTicks();
+        const double s = std::chrono::duration<double>(t1 - t0).count();
+        return (double)(c1 - c0) / s;
+#elif defined(DRUMBOX_CPU_CNTVCT)
+        u64 f;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(f));
+        return (double)f;
+#else
+        return 1.0e9;
+#endif
+    }();
+    return rate;
+}
+
+// Charge CPU du rendu, mesurée par callback sur le thread audio, lisible depuis
+// n'importe quel thread sans verrou.
+// Charge = temps de rendu / durée du bloc (1 = 100 % : l'échéance est atteinte).
+// - anneau des kRingSize derniers callbacks (charge totale + par étage)
+// - cumulés depuis prepare()/resetStats() : pire cas, histogramme, xruns
+// Un xrun compte ici un callback plus long que son bloc (échéance ratée côté moteur) ;
+// les xruns du driver lui-même ne sont pas visibles d'ici.
+class CpuMeter
+{
+public:
+    enum Stage { Voices, Reverb, Fx, Master, kNumStages };
+
+    static constexpr int kRingSize = 256;  // puissance de 2
+    static constexpr int kHistBins = 11;   // tranches de 10 %, la dernière = >= 100 %
+
+    struct Snapshot
+    {
+        float load = 0.0f;          // moyenne sur l'anneau
+        float peak = 0.0f;          // max sur l'anneau
+        float worst = 0.0f;         // max cumulé
+        float stage[kNumStages]{};  // moyenne par étage (même unité que load)
+        u64   blocks = 0;           // callbacks mesurés (cumulé)
+        u64   xruns = 0;
+        u64   histogram[kHistBins]{};
+    };
+
+    // Non temps réel
+    void prepare(double sampleRate)
+    {
+        ticksPerSample_ = cpuTicksPerSecond() / sampleRate;
+        for (auto& t : stageTicks_)
+            t = 0;
+        written_.store(0, std::memory_order_relaxed);
+        clearTotals();
+    }
+
+    // N'importe quel thread : remise à zéro des cumulés au prochain callback
+    void resetStats() { resetRequested_.store(true, std::memory_order_relaxed); }
+
+    // --- thread audio ---
+
+    // Ajoute le temps écoulé depuis since à un étage, renvoie l'instant courant
+    u64 lap(Stage stage, u64 since)
+    {
+        const u64 now = cpuTicks();
+        stageTicks_[stage] += now - since;
+        return now;
+    }
+
+    // Fin de callback commencé à start (cpuTicks()), numFrames rendus
+    void endBlock(u64 start, int numFrames)
+    {
+        const u64 now = cpuTicks();
+        if (numFrames <= 0 || ticksPerSample_ <= 0.0)
+            return;
+
+        if (resetRequested_.exchange(false, std::memory_order_relaxed))
+            clearTotals();
+
+        const double budget = ticksPerSample_ * (double)numFrames;
+        const float load = (float)((double)(now - start) / budget);
+
+        const u64 w = written_.load(std::memory_order_relaxed);
+        Entry& e = ring_[w & (kRingSize - 1)];
+        e.load.store(load, std::memory_order_relaxed);
+        for (int s = 0; s < kNumStages; ++s)
+        {
+            e.stage[s].store((float)((double)stageTicks_[s] / budget), std::memory_order_relaxed);
+            stageTicks_[s] = 0;
+        }
+        written_.store(w + 1, std::memory_order_release);
+
+        // un seul écrivain : load + store, pas de RMW
+        if (load > worst_.load(std::memory_order_relaxed))
+            worst_.store(load, std::memory_order_relaxed);
+        bump(blocks_);
+        if (load >= 1.0f)
+            bump(xruns_);
+
+        int bin = (int)(load * 10.0f);
+        if (bin > kHistBins - 1)
+            bin = kHistBins - 1;
+        bump(hist_[bin]);
+    }
+
+    // --- n'importe quel thread ---
+
+    // Les entrées de l'anneau sont lues une à une : si l'audio en réécrit pendant la
+    // lecture, le résultat mélange des callbacks récents (sans conséquence pour des stats).
+    Snapshot read() const
+    {
+        Snapshot s;
+        const u64 w = written_.load(std::memory_order_acquire);
+        const int n = (w < (u64)kRingSize) ? (int)w : kRingSize;
+
+        for (int i = 0; i < n; ++i)
+        {
+            const Entry& e = ring_[(w - 1 - (u64)i) & (kRingSize - 1)];
+            const float l = e.load.load(std::memory_order_relaxed);
+            s.load += l;
+            if (l > s.peak)
+                s.peak = l;
+            for (int k = 0; k < kNumStages; ++k)
+                s.stage[k] += e.stage[k].load(std::memory_order_relaxed);
+        }
+
+        if (n > 0)
+        {
+            const float inv = 1.0f / (float)n;
+            s.load *= inv;
+            for (int k = 0; k < kNumStages; ++k)
+                s.stage[k] *= inv;
+        }
+
+        s.worst = worst_.load(std::memory_order_relaxed);
+        s.blocks = blocks_.load(std::memory_order_relaxed);
+        s.xruns = xruns_.load(std::memory_order_relaxed);
+        for (int b = 0; b < kHistBins; ++b)
+            s.histogram[b] = hist_[b].load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct Entry
+    {
+        std::atomic<float> load{0.0f};
+        std::atomic<float> stage[kNumStages]{};
+    };
+
+    static void bump(std::atomic<u64>& c)
+    {
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void clearTotals()
+    {
+        worst_.store(0.0f, std::memory_order_relaxed);
+        blocks_.store(0, std::memory_order_relaxed);
+        xruns_.store(0, std::memory_order_relaxed);
+        for (auto& h : hist_)
+            h.store(0, std::memory_order_relaxed);
+    }
+
+    // thread audio uniquement
+    double ticksPerSample_ = 0.0;
+    u64 stageTicks_[kNumStages]{};
+
+    Entry ring_[kRingSize]{};
+    alignas(64) std::atomic<u64> written_{0};
+    std::atomic<float> worst_{0.0f};
+    std::atomic<u64> blocks_{0};
+    std::atomic<u64> xruns_{0};
+    std::atomic<u64> hist_[kHistBins]{};
+    std::atomic<bool> resetRequested_{false};
+};
+
+} // namespace drumbox_core
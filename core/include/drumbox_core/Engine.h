@@ -3,17 +3,25 @@
 #pragma once
 #include "drumbox_core/Types.h"
 #include "drumbox_core/seq/Pattern.h"
+#include "drumbox_core/seq/PatternBank.h"
 #include "drumbox_core/seq/Transport.h"
 #include "drumbox_core/drums/Kick.h"
+#include "drumbox_core/drums/KickCache.h"
 #include "drumbox_core/drums/Snare.h"
 #include "drumbox_core/drums/HiHat.h"
+#include "drumbox_core/drums/VoicePool.h"
 #include "drumbox_core/Params.h"
+#include "drumbox_core/CpuMeter.h"
+#include "drumbox_core/Command.h"
+#include "drumbox_core/LockFreeRing.h"
 
+#include "drumbox_core/dsp/DelayArena.h"
 #include "drumbox_core/dsp/ReverbSchroeder.h"
 #include "drumbox_core/dsp/FxSection.h"
 #include "drumbox_core/dsp/MasterSection.h"
 
 #include <atomic>
+#include <memory>
 
 namespace drumbox_core {
 
@@ -25,40 +33,178 @@ public:
     void prepare(double sampleRate, int maxBlockSize);
     void reset();
 
+    // Options mémoire, à régler avant prepare() (non temps réel) :
+    // - reverb désactivée : aucune ligne à retard réservée pour elle
+    // - sample rate max : l'arena est dimensionnée pour ce sr, un prepare()
+    //   à un sr inférieur ou égal ne réalloue pas
+    void setReverbEnabled(bool enabled) { reverbEnabled_ = enabled; }
+    void setMaxSampleRate(double sampleRate) { maxSampleRate_ = sampleRate; }
+    size_t delayMemoryBytes() const { return arena_.capacity() * sizeof(float); }
+
+    // Kick en cache : chaque coup à réglages fixes est rendu une fois par vélocité,
+    // puis rejoué depuis un buffer (repli en live si LFO / modif de params).
+    // Coûte KickCache::kLayers * kKickCacheSeconds de mémoire, réservée au prepare().
+    void setKickCacheEnabled(bool enabled) { kickCacheEnabled_ = enabled; }
+    size_t kickCacheMemoryBytes() const { return kickCache_.memoryBytes(); }
+
+    // Banque de patterns (avant prepare()) : numLanes lanes (les lanes >= kLanes
+    // n'ont pas d'instrument, elles ne déclenchent rien), numPatterns patterns.
+    void setPatternLayout(int numLanes, int numPatterns) { patternLanes_ = numLanes; patternCount_ = numPatterns; }
+
     void setBpm(float bpm);
     void setPlaying(bool play);
 
+    // Édition : thread audio (ou avant process()). Sans pattern explicite,
+    // le pattern en cours de lecture.
     void setStep(int lane, int step, bool on, float velocity);
-    
+    void setStep(int pattern, int lane, int step, bool on, float velocity);
+    void setPatternLength(int pattern, int steps);
+
     void clearPattern();
+    void clearPattern(int pattern);
+
+    // Changement de pattern à la fin du pattern en cours (sans coupure)
+    void queuePattern(int pattern);
+
+    // Mode song : à chaque fin de pattern, entrée suivante de la chaîne (en boucle).
+    // Un queuePattern() reste prioritaire.
+    void setSongChain(const int* patterns, int count);
+    void setSongMode(bool on);
+
+    const PatternBank& patterns() const { return patterns_; }
+
+    // Note externe (MIDI/host) déclenchée au frame frameOffset du prochain process().
+    // A appeler depuis le thread audio, avant process(). Un offset >= numFrames
+    // est reporté sur les blocs suivants. Renvoie false si la file est pleine.
+    bool pushEvent(int frameOffset, int lane, float velocity);
+
+    // Commandes (steps, patterns, params, triggers, transport) depuis n'importe quel
+    // thread, sans verrou : appliquées par le thread audio au début du process() suivant,
+    // au plus kMaxCommandsPerBlock par bloc (le reste au bloc d'après).
+    // Renvoie false si la file est pleine.
+    bool pushCommand(const Command& command) { return commands_.push(command); }
 
     // rendu interleaved: out[frame*ch + c]
     void process(float* outInterleaved, int numFrames, int numChannels);
 
+    // rendu planar: channels[c][frame], écrit directement dans les buffers du host
+    // (canal 0 = L, 1 = R, mono et canaux au-delà de 2 = (L+R)/2)
+    void processPlanar(float* const* channels, int numChannels, int numFrames);
+
     // lecture (pour UI plus tard)
     int getStepIndex() const { return playheadStep_.load(std::memory_order_relaxed); }
+    int getPatternIndex() const { return playheadPattern_.load(std::memory_order_relaxed); }
     float getBpm() const { return transport_.bpm; }
+
+    // Charge CPU par callback (voix / reverb / FX / master), lisible depuis n'importe quel thread
+    const CpuMeter& cpuMeter() const { return cpu_; }
+    CpuMeter& cpuMeter() { return cpu_; }
     bool isPlaying() const { return transport_.playing; }
 
 private:
+    // Taille max d'un sous-bloc de rendu : les buffers de travail font
+    // min(maxBlockSize, kMaxSubBlock) frames, les blocs plus grands sont découpés
+    static constexpr int kMaxSubBlock = 256;
+
+    // Capacité de la file d'événements externes (fixe, sans allocation)
+    static constexpr int kMaxEvents = 256;
+
+    struct NoteEvent
+    {
+        int frame = 0;   // offset dans le bloc courant
+        int lane = 0;
+        float vel = 1.0f;
+    };
+
+    // File de commandes des front ends (cases sur le tas, ~40 Ko alloués à la
+    // construction de l'Engine), et borne de traitement par process()
+    static constexpr int kCommandQueueSize = 1024;
+    static constexpr int kMaxCommandsPerBlock = 256;
+
+    // Polyphonie par lane (rolls/flams sans couper la queue précédente)
+    static constexpr int kVoicesPerLane = 4;
+
+    // Durée max d'un coup de kick en cache (au-delà : toujours en live)
+    static constexpr float kKickCacheSeconds = 1.0f;
+
+    // Buffers de travail d'un sous-bloc, découpés dans un seul bloc alloué par prepare()
+    struct Scratch
+    {
+        float* kick = nullptr;
+        float* dry = nullptr;
+        float* wetL = nullptr;
+        float* wetR = nullptr;
+        float* fxL = nullptr;
+        float* fxR = nullptr;
+        float* voice = nullptr; // somme des voix d'une lane
+
+        static constexpr int kNumBuffers = 7;
+    };
+
+    // Destination du rendu : interleaved ou planar (un seul des deux non nul)
+    struct Output
+    {
+        float* interleaved = nullptr;
+        float* const* planar = nullptr;
+        int numChannels = 0;
+    };
+
+    void applyParams(u32 dirty);
+    void drainCommands();
+    void applyCommand(const Command& c);
     void triggerStep(int stepIndex);
+    void advanceStep();
+    void triggerLane(int lane, float velocity);
+    bool voicesActive() const { return kicks_.isActive() || snares_.isActive() || hats_.isActive(); }
+    void render(const Output& out, int numFrames);
+    void renderSubBlock(const Output& out, int offset, int numFrames);
+    void writeOutput(const Output& out, int offset, int numFrames);
 
     double sampleRate_ = 48000.0;
     int maxBlock_ = 0;
 
-    Pattern pattern_{};
+    // Patterns : le séquenceur lit curPattern_, change au bout du pattern
+    // (queuedPattern_ puis chaîne song)
+    PatternBank patterns_{};
+    int  patternLanes_ = kLanes;
+    int  patternCount_ = 16;
+    int  curPattern_ = 0;
+    int  queuedPattern_ = -1;
+    bool songMode_ = false;
+    int  chainPos_ = -1;
+
     Transport transport_{};
     std::atomic<int> playheadStep_{0};
+    std::atomic<int> playheadPattern_{0};
     
     Params params_{};
+    u32 paramGeneration_ = ~0u; // dernière génération appliquée
+
+    VoicePool<Kick,  kVoicesPerLane> kicks_{};
+    VoicePool<Snare, kVoicesPerLane> snares_{};
+    VoicePool<HiHat, kVoicesPerLane> hats_{};
 
-    Kick  kick_{};
-    Snare snare_{};
-    HiHat hat_{};
+    KickCache kickCache_{};
+    bool      kickCacheEnabled_ = false;
+
+    DelayArena      arena_{};   // lignes à retard reverb + diffuseur FX
+    bool   reverbEnabled_ = true;
+    double maxSampleRate_ = 0.0;
 
     ReverbSchroeder reverb_{};
     FxSection       fx_{};
     MasterSection  master_{};
+
+    Scratch scratch_{};
+    CpuMeter cpu_{};
+    std::unique_ptr<float[]> scratchMem_;
+    int subBlock_ = 0; // frames par buffer de scratch_ (0 = pas encore préparé)
+
+    // triés par frame (ordre d'arrivée conservé à frame égal)
+    NoteEvent events_[kMaxEvents]{};
+    int numEvents_ = 0;
+
+    MpscRing<Command, kCommandQueueSize> commands_{};
 };
 
 } // namespace drumbox_core
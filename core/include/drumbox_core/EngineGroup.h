@@ -0,0 +1,88 @@
+// Drumbox/core/include/drumbox_core/EngineGroup.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+#include "drumbox_core/Engine.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace drumbox_core {
+
+// N Engines (une par piste) rendues en parallèle sur un pool fixe de threads.
+// - distribution lock-free : compteur atomique d'index, le thread appelant participe
+// - somme dans le bus de mix dans l'ordre des index (résultat déterministe)
+// - temps de rendu mesuré par instance
+//
+// prepare()/release() : thread non temps réel (allocations, création des threads).
+// process() : thread audio. Les params / pushEvent de chaque Engine se font
+// depuis le thread audio avant process(), comme pour une Engine seule.
+class EngineGroup {
+public:
+    EngineGroup() = default;
+    ~EngineGroup();
+
+    EngineGroup(const EngineGroup&) = delete;
+    EngineGroup& operator=(const EngineGroup&) = delete;
+
+    // numWorkers: threads en plus de l'appelant (0 = rendu série dans process),
+    // limité à (coeurs - 1)
+    // maxChannels : canaux rendus par chaque Engine (au moins 2). process() accepte
+    // plus de canaux : ceux au-delà reçoivent (L+R)/2, comme Engine::process.
+    void prepare(int numEngines, double sampleRate, int maxBlockSize,
+                 int numWorkers, int maxChannels = 2);
+    void release();
+
+    int size() const { return numEngines_; }
+    int numWorkers() const { return (int)workers_.size(); }
+    Engine& engine(int index) { return engines_[(size_t)index]; }
+
+    // Rend toutes les Engines et écrit la somme (interleaved, numChannels quelconque) dans out.
+    void process(float* outInterleaved, int numFrames, int numChannels);
+
+    // CPU par instance (lisible depuis n'importe quel thread)
+    u64 lastProcessNs(int index) const;
+    float cpuLoad(int index) const; // temps de rendu / durée du bloc (lissé)
+
+private:
+    struct alignas(64) InstanceStats
+    {
+        std::atomic<u64> lastNs{0};
+        std::atomic<float> load{0.0f};
+    };
+
+    void workerLoop();
+    void runJobs();
+    void renderOne(int index);
+
+    std::unique_ptr<Engine[]> engines_;
+    std::unique_ptr<InstanceStats[]> stats_;
+    std::vector<float> buffers_; // un buffer interleaved par Engine
+    int numEngines_ = 0;
+    int bufferStride_ = 0;
+    int maxBlock_ = 0;
+    int maxChannels_ = 2;
+    double sampleRate_ = 48000.0;
+
+    // job courant (écrit par process avant la publication de l'epoch)
+    int jobFrames_ = 0;
+    int jobChannels_ = 0;
+
+    alignas(64) std::atomic<u32> epoch_{0};
+    alignas(64) std::atomic<int> nextIndex_{0};
+    alignas(64) std::atomic<int> doneCount_{0};
+    std::atomic<bool> quit_{false};
+
+    // réveil des workers endormis (uniquement après une longue inactivité)
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<int> sleepers_{0};
+
+    std::vector<std::thread> workers_;
+};
+
+} // namespace drumbox_core
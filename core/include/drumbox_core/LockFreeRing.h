@@ -0,0 +1,93 @@
+// Drumbox/core/include/drumbox_core/LockFreeRing.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+
+#include <atomic>
+#include <memory>
+
+namespace drumbox_core {
+
+// File sans verrou : plusieurs producteurs (n'importe quels threads), un consommateur.
+// Capacité fixe, puissance de 2 ; index u32 monotones (masque, pas de modulo) ;
+// index producteurs et index consommateur sur des lignes de cache séparées.
+// Cases allouées une fois dans le constructeur (hors de l'objet : une Engine reste
+// compacte), jamais ensuite : push()/pop() n'allouent pas.
+// Numéro de séquence par case (Vyukov) : un producteur réserve une case par CAS sur
+// head_, l'écrit, puis la publie via son seq. Le consommateur ne fait que des
+// load/store : pop() ne boucle jamais.
+template <typename T, int Capacity>
+class MpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity : puissance de 2");
+
+public:
+    MpscRing()
+        : slots_(new Slot[(size_t)Capacity])
+    {
+        for (u32 i = 0; i < (u32)Capacity; ++i)
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // N'importe quel thread. false si la file est pleine.
+    bool push(const T& v)
+    {
+        u32 pos = head_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot& s = slots_[pos & kMask];
+            const u32 seq = s.seq.load(std::memory_order_acquire);
+            const i32 diff = (i32)(seq - pos);
+            if (diff == 0)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    s.value = v;
+                    s.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // pos rechargé par le CAS
+            }
+            else if (diff < 0)
+            {
+                return false; // pleine : la case n'a pas encore été consommée
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consommateur unique. Une case réservée mais pas encore publiée = file vide pour l'instant.
+    bool pop(T& out)
+    {
+        Slot& s = slots_[tail_ & kMask];
+        const u32 seq = s.seq.load(std::memory_order_acquire);
+        if (seq != tail_ + 1)
+            return false;
+
+        out = s.value;
+        s.seq.store(tail_ + (u32)Capacity, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+private:
+    static constexpr u32 kMask = (u32)Capacity - 1;
+
+    struct Slot
+    {
+        std::atomic<u32> seq{0};
+        T value{};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<u32> head_{0}; // producteurs
+    alignas(64) u32 tail_ = 0;             // consommateur
+};
+
+} // namespace drumbox_core
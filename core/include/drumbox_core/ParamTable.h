@@ -0,0 +1,126 @@
+// Drumbox/core/include/drumbox_core/ParamTable.h
+
+// Table unique des paramètres : DRUMBOX_PARAM(nom, défaut, groupe de dirty tracking).
+// Inclus plusieurs fois par Params.h (X-macro) : pas de #pragma once.
+// Ajouter un paramètre ici suffit pour Params, ParamSnapshot, snapshot()/apply()
+// et la sérialisation par nom (kParamInfo / findParam).
+
+#ifndef DRUMBOX_PARAM
+#error "ParamTable.h : définir DRUMBOX_PARAM(name, def, group) avant l'include"
+#endif
+
+// Global
+DRUMBOX_PARAM(masterGain,            0.6f,     Master)
+
+// Master (EQ + clipper)
+DRUMBOX_PARAM(masterEqLowDb,         0.0f,     Master)     // -24..24
+DRUMBOX_PARAM(masterEqMidDb,         0.0f,     Master)     // -24..24
+DRUMBOX_PARAM(masterEqHighDb,        0.0f,     Master)     // -24..24
+DRUMBOX_PARAM(masterClipOn,          1.0f,     Master)     // 0/1
+DRUMBOX_PARAM(masterClipMode,        0.0f,     Master)     // 0=soft, 1=hard
+
+// Kick
+DRUMBOX_PARAM(kickDecay,             0.9995f,  Kick)
+DRUMBOX_PARAM(kickPitchDecay,        0.9930f,  Kick)
+DRUMBOX_PARAM(kickDriveDecay,        0.9900f,  Kick)
+DRUMBOX_PARAM(kickAttackFreq,        120.0f,   Kick)
+DRUMBOX_PARAM(kickBaseFreq,          55.0f,    Kick)
+DRUMBOX_PARAM(kickDriveAmount,       14.0f,    Kick)
+DRUMBOX_PARAM(kickClickGain,         0.70f,    Kick)
+DRUMBOX_PARAM(kickPreHpHz,           30.0f,    KickFilter)
+DRUMBOX_PARAM(kickPostGain,          0.85f,    Kick)
+
+// Post shaping (gabber/hardstyle)
+DRUMBOX_PARAM(kickPostLpHz,          8000.0f,  KickFilter)
+DRUMBOX_PARAM(kickPostHpHz,          25.0f,    KickFilter)
+DRUMBOX_PARAM(kickClipMode,          0.0f,     Kick)       // 0=tanh, 1=hard clip, 2=foldback
+
+// Kickbass extensions
+DRUMBOX_PARAM(kickTailDecay,         0.9992f,  Kick)
+DRUMBOX_PARAM(kickTailMix,           0.45f,    Kick)       // 0..1
+DRUMBOX_PARAM(kickTailFreqMul,       1.0f,     Kick)       // 1..4
+DRUMBOX_PARAM(kickSubMix,            0.35f,    Kick)       // 0..1 (sub propre en parallèle)
+DRUMBOX_PARAM(kickSubLpHz,           180.0f,   KickFilter)
+DRUMBOX_PARAM(kickFeedback,          0.08f,    Kick)       // 0..0.5 typique
+
+// Kick transient character
+DRUMBOX_PARAM(kickTokAmount,         0.20f,    Kick)       // 0..1
+DRUMBOX_PARAM(kickTokHpHz,           180.0f,   KickFilter)
+DRUMBOX_PARAM(kickCrunchAmount,      0.15f,    Kick)       // 0..1
+
+// 2 dist chains + TOK/CRUNCH
+// clipMode -1 = suit kickClipMode global, sinon 0=tanh, 1=hard, 2=fold
+DRUMBOX_PARAM(kickChain1Mix,         0.70f,    Kick)       // 0..1
+DRUMBOX_PARAM(kickChain1DriveMul,    1.00f,    Kick)       // multiplicateur de drive
+DRUMBOX_PARAM(kickChain1LpHz,        9000.0f,  KickFilter)
+DRUMBOX_PARAM(kickChain1Asym,        0.00f,    Kick)       // -1..1
+DRUMBOX_PARAM(kickChain1ClipMode,    -1.0f,    Kick)
+
+DRUMBOX_PARAM(kickChain2Mix,         0.30f,    Kick)       // 0..1
+DRUMBOX_PARAM(kickChain2DriveMul,    1.60f,    Kick)
+DRUMBOX_PARAM(kickChain2LpHz,        5200.0f,  KickFilter)
+DRUMBOX_PARAM(kickChain2Asym,        0.20f,    Kick)
+DRUMBOX_PARAM(kickChain2ClipMode,    -1.0f,    Kick)
+
+// Kick layers (2 mini-synths) - coefficients DSP pour A/D
+// layerType: 0=sine, 1=triangle, 2=square, 3=noise
+DRUMBOX_PARAM(kickLayer1Enabled,     0.0f,     KickLayers)
+DRUMBOX_PARAM(kickLayer1Type,        0.0f,     KickLayers)
+DRUMBOX_PARAM(kickLayer1FreqHz,      110.0f,   KickLayers)
+DRUMBOX_PARAM(kickLayer1Phase01,     0.0f,     KickLayers) // 0..1
+DRUMBOX_PARAM(kickLayer1Drive,       0.0f,     KickLayers) // 0..1 (drive interne)
+DRUMBOX_PARAM(kickLayer1AttackCoeff, 0.05f,    KickLayers) // 0..1 (0=instant)
+DRUMBOX_PARAM(kickLayer1DecayCoeff,  0.9992f,  KickLayers)
+DRUMBOX_PARAM(kickLayer1Vol,         0.0f,     KickLayers) // gain lin
+
+DRUMBOX_PARAM(kickLayer2Enabled,     0.0f,     KickLayers)
+DRUMBOX_PARAM(kickLayer2Type,        1.0f,     KickLayers)
+DRUMBOX_PARAM(kickLayer2FreqHz,      220.0f,   KickLayers)
+DRUMBOX_PARAM(kickLayer2Phase01,     0.0f,     KickLayers)
+DRUMBOX_PARAM(kickLayer2Drive,       0.0f,     KickLayers)
+DRUMBOX_PARAM(kickLayer2AttackCoeff, 0.05f,    KickLayers)
+DRUMBOX_PARAM(kickLayer2DecayCoeff,  0.9992f,  KickLayers)
+DRUMBOX_PARAM(kickLayer2Vol,         0.0f,     KickLayers)
+
+// Kick LFO (modulation)
+// shape: 0=sine, 1=triangle, 2=square ; target: 0=pitch, 1=drive, 2=cutoff, 3=phase
+DRUMBOX_PARAM(kickLfoAmount,         0.0f,     KickLfo)    // 0..1
+DRUMBOX_PARAM(kickLfoRateHz,         2.0f,     KickLfo)    // Hz
+DRUMBOX_PARAM(kickLfoShape,          0.0f,     KickLfo)    // 0..2
+DRUMBOX_PARAM(kickLfoTarget,         0.0f,     KickLfo)    // 0..3
+DRUMBOX_PARAM(kickLfoPulse,          0.5f,     KickLfo)    // 0..1 (square duty)
+
+// Kick Reverb (kick-tail)
+DRUMBOX_PARAM(kickReverbAmount,      0.0f,     Reverb)     // 0..1 (wet)
+DRUMBOX_PARAM(kickReverbSize,        0.35f,    Reverb)     // 0..1
+DRUMBOX_PARAM(kickReverbTone,        0.55f,    Reverb)     // 0..1 (bright)
+
+// Kick FX
+DRUMBOX_PARAM(kickFxShiftHz,         0.0f,     Fx)         // -2000..2000
+DRUMBOX_PARAM(kickFxStereo,          0.0f,     Fx)         // 0..1 (width)
+DRUMBOX_PARAM(kickFxDiffusion,       0.0f,     Fx)         // 0..1 (all-pass feedback)
+DRUMBOX_PARAM(kickFxCleanDirty,      1.0f,     Fx)         // 0..1 (0=clean, 1=dirty)
+DRUMBOX_PARAM(kickFxTone,            0.5f,     Fx)         // 0..1 (0=dark, 1=bright)
+// FX envelope (transient emphasis on FX path)
+DRUMBOX_PARAM(kickFxEnvAttackCoeff,  0.05f,    Fx)         // 0..1 (0=instant)
+DRUMBOX_PARAM(kickFxEnvDecayCoeff,   0.995f,   Fx)         // 0..1 (close to 1 = long)
+DRUMBOX_PARAM(kickFxEnvVol,          0.0f,     Fx)         // 0..1
+DRUMBOX_PARAM(kickFxDisperse,        0.0f,     Fx)         // 0..1
+DRUMBOX_PARAM(kickFxInflator,        0.0f,     Fx)         // 0..1
+DRUMBOX_PARAM(kickFxInflatorMix,     0.5f,     Fx)         // 0..1
+DRUMBOX_PARAM(kickFxOttAmount,       0.0f,     Fx)         // 0..1
+
+// Oversampling (qualité disto) : 0=off, 1=2x, 2=4x, 3=8x
+DRUMBOX_PARAM(kickOversample,        0.0f,     KickFilter)
+
+// Backend math du kick : 0=fast (tables/approx), 1=reference (libm, A/B)
+DRUMBOX_PARAM(kickMathMode,          0.0f,     Kick)
+
+// Snare
+DRUMBOX_PARAM(snareDecay,            0.9975f,  Snare)
+DRUMBOX_PARAM(snareToneFreq,         180.0f,   Snare)
+DRUMBOX_PARAM(snareNoiseMix,         0.75f,    Snare)
+
+// Hat
+DRUMBOX_PARAM(hatDecay,              0.96f,    Hat)
+DRUMBOX_PARAM(hatCutoff,             7000.0f,  Hat)
@@ -8,7 +8,9 @@ using u32 = uint32_t;
 using u64 = uint64_t;
 
 constexpr int kLanes = 3;     // Kick, Snare, Hat
-constexpr int kSteps = 16;    // 16-step sequencer
+constexpr int kSteps = 16;    // 16-step sequencer (longueur par défaut d'un pattern)
+constexpr int kMaxSteps = 64; // longueur max d'un pattern (masque u64 par lane)
+constexpr int kMaxLanes = 64; // lanes max d'une PatternBank (masque u64 par step)
 constexpr float kPi = 3.14159265358979323846f;
 
 } // namespace drumbox_core
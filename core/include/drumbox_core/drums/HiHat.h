@@ -29,6 +29,9 @@ struct HiHat {
         hp.setCutoff(cutoff, (float)sr);
     }
 
+    void reseed(u32 salt) { noise.seed(noise.state ^ salt); }
+    void stop() { active = false; }
+
     void trigger(float vel) {
         active = true;
         ampEnv.trigger(vel);
@@ -46,6 +49,20 @@ struct HiHat {
         if (!ampEnv.isActive()) active = false;
         return out;
     }
+
+    // Rendu d'un bloc mono (écrit dst[0..n), zéros une fois la voix éteinte).
+    void processBlock(float* dst, int n) {
+        int i = 0;
+        for (; i < n && active; ++i)
+        {
+            const float amp = ampEnv.process();
+            dst[i] = amp * hp.process(noise.white());
+
+            if (!ampEnv.isActive()) active = false;
+        }
+        for (; i < n; ++i)
+            dst[i] = 0.0f;
+    }
 };
 
 } // namespace drumbox_core
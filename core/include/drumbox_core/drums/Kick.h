@@ -4,11 +4,15 @@
 #include "drumbox_core/Types.h"
 #include "drumbox_core/dsp/EnvelopeExp.h"
 #include "drumbox_core/dsp/EnvelopeADExp.h"
+#include "drumbox_core/dsp/FastMath.h"
 #include "drumbox_core/dsp/OnePole.h"
 #include "drumbox_core/dsp/Lfo.h"
 #include "drumbox_core/dsp/Noise.h"
 #include "drumbox_core/dsp/Saturation.h"
-#include "drumbox_core/dsp/Oversampling2x.h"
+#include "drumbox_core/dsp/Oversampler.h"
+#include "drumbox_core/dsp/PolyBlep.h"
+#include "drumbox_core/dsp/Smoother.h"
+#include "drumbox_core/drums/KickCache.h"
 #include <cmath>
 
 namespace drumbox_core {
@@ -116,13 +120,35 @@ struct Kick {
     float lfoPulse  = 0.5f; // square duty
     Lfo   lfo;
 
-    bool oversample2x = false;
-    Oversampling2x os2x;
+    int oversampleFactor = 1; // 1/2/4/8 : taux de la partie disto/post
+    Oversampler os;
+
+    // Backend sin/tanh/pow/fmod : Fast par défaut, Reference pour A/B
+    MathMode mathMode = MathMode::Fast;
+
+    // postLP a été modifié par le LFO (cutoff) : à restaurer quand la modulation s'arrête
+    bool postLpModulated = false;
 
     float sr_ = 48000.0f;
 
+    // drive / gain de sortie lissés (bouton tourné pendant la queue)
+    SmoothedValue driveSm_;
+    SmoothedValue postGainSm_;
+
+    // Cache (KickCache) : lecture d'un coup pré-rendu, ou enregistrement du coup live
+    KickCacheSlot* cacheRead_ = nullptr;  // couche lue (comptée dans ses readers)
+    int            cacheLen_ = 0;
+    int            cachePos_ = 0;
+    float          cacheGain_ = 1.0f;
+    KickCacheSlot* cacheRec_ = nullptr;
+    u32            cacheRecGen_ = 0;
+
     void prepare(double sr) {
         sr_ = (float)sr;
+        cacheRead_ = nullptr;
+        cacheRec_ = nullptr;
+        driveSm_.prepare(sr_, 10.0f);
+        postGainSm_.prepare(sr_, 10.0f);
         // AMP ~200-250ms
         ampEnv.setDecay(0.9994f);
 
@@ -150,14 +176,23 @@ struct Kick {
         layer2Env.value = 0.0f;
 
         lfo.reset(0.0f);
-        os2x.reset();
+        os.reset();
     }
 
+    // décorrèle le bruit de click entre voix d'un pool
+    void reseed(u32 salt) { seed ^= salt; }
+
     void trigger(float vel) {
+        detachCache(); // coup précédent pas fini : lecture rendue, enregistrement perdu
+
         active = true;
         phase = 0.0f;
         hitVel = vel;
 
+        // nouvelle note : directement aux valeurs courantes
+        driveSm_.snap(driveAmount);
+        postGainSm_.snap(postGain);
+
         ampEnv.trigger(vel);
         pitchEnv.trigger(1.0f);
         driveEnv.trigger(1.0f);
@@ -200,37 +235,147 @@ struct Kick {
 
         // LFO resync sur chaque hit (plus musical pour un kick)
         lfo.reset(0.0f);
-        os2x.reset();
+        os.reset();
     }
 
-    inline float processDirtyPath(float xDrive)
+    // Valeurs dérivées des params, figées pour la durée d'un bloc
+    // (clamps, modes, incréments de phase) : rien à recalculer par sample.
+    struct LayerConsts
+    {
+        bool  on = false;
+        int   type = 0;
+        float phaseInc = 0.0f;
+        float dt = 0.0f;       // incrément normalisé (PolyBLEP)
+        float volLin = 0.0f;
+        float driveGain = 1.0f;
+    };
+
+    struct BlockConsts
+    {
+        float sr = 48000.0f;
+        float srDist = 48000.0f;
+
+        // LFO
+        float lfoAmount = 0.0f;
+        bool  lfoOn = false;
+        int   lfoShape = 0;
+        int   lfoTarget = 0;
+
+        float tailInc = 0.0f;
+        float tailDt = 0.0f;
+        float tailMix = 0.0f;
+        float feedback = 0.0f;
+        float subMix = 0.0f;
+
+        // lissés : mis à jour par sample pendant une rampe
+        float driveAmount = 14.0f;
+        float postGain = 0.85f;
+
+        // chemin dirty
+        float chain1DriveMul = 1.0f;
+        float chain2DriveMul = 1.0f;
+        int   chain1Mode = 0;
+        int   chain2Mode = 0;
+        float chain1Mix = 0.0f;
+        float chain2Mix = 0.0f;
+        float tokAmount = 0.0f;
+        float crunch = 0.0f;
+
+        LayerConsts layer1;
+        LayerConsts layer2;
+    };
+
+    LayerConsts makeLayerConsts(float enabled, float typeF, float freqHz,
+                                float volLin, float drive01, float sr) const
+    {
+        LayerConsts l;
+        l.on = !(enabled < 0.5f || volLin <= 0.0f);
+        l.type = (int)clampf(typeF, 0.0f, 3.0f);
+        const float hz = clampf(freqHz, 1.0f, 20000.0f);
+        l.phaseInc = (2.0f * kPi) * hz / maxf(1.0f, sr);
+        l.dt = hz / maxf(1.0f, sr);
+        l.volLin = volLin;
+        l.driveGain = 1.0f + 16.0f * clampf(drive01, 0.0f, 1.0f);
+        return l;
+    }
+
+    BlockConsts makeBlockConsts(float sr)
+    {
+        BlockConsts c;
+        c.sr = sr;
+        os.setFactor(oversampleFactor);
+        c.srDist = sr * (float)os.factor();
+
+        c.lfoAmount = clampf(lfoAmount, 0.0f, 1.0f);
+        c.lfoOn = c.lfoAmount > 0.0001f;
+        c.lfoShape = (int)clampf(lfoShape, 0.0f, 2.0f);
+        c.lfoTarget = (int)clampf(lfoTarget, 0.0f, 3.0f);
+
+        if (c.lfoOn && c.lfoTarget == 2)
+            postLpModulated = true;
+        else if (postLpModulated)
+        {
+            postLP.setCutoff(postLpHz, c.srDist);
+            postLpModulated = false;
+        }
+
+        const float tailFreq = maxf(1.0f, baseFreq * clampf(tailFreqMul, 1.0f, 4.0f));
+        c.tailInc = (2.0f * kPi) * tailFreq / sr;
+        c.tailDt = tailFreq / sr;
+        c.tailMix = clampf(tailMix, 0.0f, 1.0f);
+        c.feedback = clampf(feedback, 0.0f, 0.5f);
+        c.subMix = clampf(subMix, 0.0f, 1.0f);
+
+        driveSm_.setTarget(driveAmount);
+        postGainSm_.setTarget(postGain);
+        c.driveAmount = driveSm_.current();
+        c.postGain = postGainSm_.current();
+
+        c.chain1DriveMul = clampf(chain1DriveMul, 0.25f, 4.0f);
+        c.chain2DriveMul = clampf(chain2DriveMul, 0.25f, 4.0f);
+        c.chain1Mode = (chain1ClipMode >= 0) ? chain1ClipMode : clipMode;
+        c.chain2Mode = (chain2ClipMode >= 0) ? chain2ClipMode : clipMode;
+        c.chain1Mix = clampf(chain1Mix, 0.0f, 1.0f);
+        c.chain2Mix = clampf(chain2Mix, 0.0f, 1.0f);
+        c.tokAmount = clampf(tokAmount, 0.0f, 1.0f);
+        c.crunch = clampf(crunchAmount, 0.0f, 1.0f);
+
+        c.layer1 = makeLayerConsts(layer1Enabled, layer1Type, layer1FreqHz, layer1Vol, layer1Drive, sr);
+        c.layer2 = makeLayerConsts(layer2Enabled, layer2Type, layer2FreqHz, layer2Vol, layer2Drive, sr);
+
+        // coeffs d'enveloppe des layers: constants sur le bloc
+        layer1Env.setAttack(clampf(layer1AttackCoeff, 0.0f, 1.0f));
+        layer1Env.setDecay(clampf(layer1DecayCoeff, 0.0f, 0.999999f));
+        layer2Env.setAttack(clampf(layer2AttackCoeff, 0.0f, 1.0f));
+        layer2Env.setDecay(clampf(layer2DecayCoeff, 0.0f, 0.999999f));
+        return c;
+    }
+
+    template <typename M>
+    inline float processDirtyPath(float xDrive, const BlockConsts& c)
     {
         // 2 chaînes de disto en parallèle (caractère)
-        float y1 = applyAsym(xDrive * clampf(chain1DriveMul, 0.25f, 4.0f), chain1Asym);
-        float y2 = applyAsym(xDrive * clampf(chain2DriveMul, 0.25f, 4.0f), chain2Asym);
+        float y1 = applyAsym(xDrive * c.chain1DriveMul, chain1Asym);
+        float y2 = applyAsym(xDrive * c.chain2DriveMul, chain2Asym);
 
-        const int m1 = (chain1ClipMode >= 0) ? chain1ClipMode : clipMode;
-        const int m2 = (chain2ClipMode >= 0) ? chain2ClipMode : clipMode;
-        y1 = applyClipper(m1, y1);
-        y2 = applyClipper(m2, y2);
+        y1 = applyClipper<M>(c.chain1Mode, y1);
+        y2 = applyClipper<M>(c.chain2Mode, y2);
 
         y1 = chain1LP.process(y1);
         y2 = chain2LP.process(y2);
 
-        const float mix1 = clampf(chain1Mix, 0.0f, 1.0f);
-        const float mix2 = clampf(chain2Mix, 0.0f, 1.0f);
-        float dirty = y1 * mix1 + y2 * mix2;
+        float dirty = y1 * c.chain1Mix + y2 * c.chain2Mix;
 
         // TOK (punch): ajoute un peu de HP (transient)
-        const float tok = tokHP.process(dirty) * clampf(tokAmount, 0.0f, 1.0f);
+        const float tok = tokHP.process(dirty) * c.tokAmount;
         dirty += tok;
 
         // CRUNCH: foldback en crossfade
-        const float cr = clampf(crunchAmount, 0.0f, 1.0f);
+        const float cr = c.crunch;
         if (cr > 0.0001f)
         {
-            const float c = foldback(dirty * (1.0f + 2.0f * cr), 1.0f);
-            dirty = dirty * (1.0f - cr) + c * cr;
+            const float f = M::foldback(dirty * (1.0f + 2.0f * cr), 1.0f);
+            dirty = dirty * (1.0f - cr) + f * cr;
         }
 
         fbZ = dirty;
@@ -248,21 +393,6 @@ struct Kick {
         return x;
     }
 
-    static inline float foldback(float x, float threshold = 1.0f) {
-        if (threshold <= 0.0f) return 0.0f;
-        const float t2 = threshold * 2.0f;
-        const float t4 = threshold * 4.0f;
-
-        if (x > threshold || x < -threshold) {
-            float y = std::fmod(x - threshold, t4);
-            if (y < 0.0f) y += t4;
-            if (y > t2) y = t4 - y;
-            y -= threshold;
-            return y;
-        }
-        return x;
-    }
-
     static inline float clampf(float v, float lo, float hi) {
         return (v < lo) ? lo : ((v > hi) ? hi : v);
     }
@@ -271,13 +401,14 @@ struct Kick {
 
     static inline float absf(float x) { return x < 0.0f ? -x : x; }
 
+    template <typename M>
     static inline float applyClipper(int mode, float x)
     {
         switch (mode)
         {
             case 1:  return hardClip(x);
-            case 2:  return foldback(x, 1.0f);
-            default: return std::tanh(x);
+            case 2:  return M::foldback(x, 1.0f);
+            default: return M::tanh(x);
         }
     }
 
@@ -289,18 +420,24 @@ struct Kick {
         return (x >= 0.0f) ? (x * gPos) : (x * gNeg);
     }
 
-    static inline float triangleFromPhase(float phase) {
-        // phase en radians [0..2pi)
+    // phase en radians [0..2pi) -> [0..1)
+    template <typename M>
+    static inline float phase01(float phase) {
         const float invTwoPi = 1.0f / (2.0f * kPi);
-        float t = phase * invTwoPi; // 0..1
-        t -= std::floor(t);
-        // 0..1 -> -1..1
-        return 4.0f * std::abs(t - 0.5f) - 1.0f;
+        float t = phase * invTwoPi;
+        return t - M::floor(t);
+    }
+
+    // Triangle / carré à bande limitée (PolyBLAMP / PolyBLEP) : pas d'aliasing
+    // à corriger par l'oversampling, qui ne sert plus qu'à la disto.
+    template <typename M>
+    static inline float triangleFromPhase(float phase, float dt) {
+        return polyblep::triangle(phase01<M>(phase), dt);
     }
 
-    static inline float squareFromPhase(float phase) {
-        // phase en radians [0..2pi)
-        return (phase < kPi) ? 1.0f : -1.0f;
+    template <typename M>
+    static inline float squareFromPhase(float phase, float dt) {
+        return polyblep::square(phase01<M>(phase), dt);
     }
 
     static inline float wrapPhase(float phase) {
@@ -311,65 +448,53 @@ struct Kick {
         return phase;
     }
 
+    template <typename M>
     static inline float semitoneRatio(float semis) {
         // ratio = 2^(semis/12)
-        return std::pow(2.0f, semis / 12.0f);
+        return M::exp2(semis / 12.0f);
     }
 
-    float processLayer(EnvelopeADExp& env,
-                       float& phaseRad,
-                       float enabled,
-                       float typeF,
-                       float freqHz,
-                       float volLin,
-                       float drive01,
-                       float attackCoeff,
-                       float decayCoeff,
-                       float sr,
-                       float phaseOffsetRad)
+    template <typename M>
+    inline float processLayer(EnvelopeADExp& env,
+                              float& phaseRad,
+                              const LayerConsts& l,
+                              float phaseOffsetRad)
     {
-        if (enabled < 0.5f || volLin <= 0.0f)
+        if (!l.on)
             return 0.0f;
 
-        env.setAttack(clampf(attackCoeff, 0.0f, 1.0f));
-        env.setDecay(clampf(decayCoeff, 0.0f, 0.999999f));
-
         const float e = env.process();
         if (e <= 0.0f)
             return 0.0f;
 
-        const int type = (int)clampf(typeF, 0.0f, 3.0f);
-        const float hz = clampf(freqHz, 1.0f, 20000.0f);
-        phaseRad += (2.0f * kPi) * hz / maxf(1.0f, sr);
+        phaseRad += l.phaseInc;
         phaseRad = wrapPhase(phaseRad);
 
         float osc = 0.0f;
         const float phaseForOsc = wrapPhase(phaseRad + phaseOffsetRad);
-        switch (type)
+        switch (l.type)
         {
             default:
-            case 0: osc = std::sinf(phaseForOsc); break;
-            case 1: osc = triangleFromPhase(phaseForOsc); break;
-            case 2: osc = squareFromPhase(phaseForOsc); break;
+            case 0: osc = M::sin(phaseForOsc); break;
+            case 1: osc = triangleFromPhase<M>(phaseForOsc, l.dt); break;
+            case 2: osc = squareFromPhase<M>(phaseForOsc, l.dt); break;
             case 3: osc = layerNoise.white(); break;
         }
 
-        const float d = clampf(drive01, 0.0f, 1.0f);
-        float x = osc * e * volLin * hitVel;
-        x = softClip(x * (1.0f + 16.0f * d));
+        float x = osc * e * l.volLin * hitVel;
+        x = softClip(x * l.driveGain);
         return x;
     }
 
-    float process(float sr) {
-        if (!active) return 0.0f;
-
-        const float srDist = oversample2x ? (2.0f * sr) : sr;
+    template <typename M>
+    inline float renderSample(const BlockConsts& c)
+    {
+        const float sr = c.sr;
 
         // LFO (par sample)
-        const float amount = clampf(lfoAmount, 0.0f, 1.0f);
-        const int shape = (int)clampf(lfoShape, 0.0f, 2.0f);
-        const int target = (int)clampf(lfoTarget, 0.0f, 3.0f);
-        const float lfoV = (amount > 0.0001f) ? lfo.process(lfoRateHz, sr, shape, lfoPulse) : 0.0f;
+        const float amount = c.lfoAmount;
+        const int target = c.lfoTarget;
+        const float lfoV = c.lfoOn ? lfo.process(lfoRateHz, sr, c.lfoShape, lfoPulse) : 0.0f;
 
         const float amp   = ampEnv.process();
         const float pitch = pitchEnv.process();
@@ -379,10 +504,10 @@ struct Kick {
         // Modulation Pitch: profondeur +/-12 demi-tons à amount=1
         float baseHz = baseFreq;
         float attackHz = attackFreq;
-        if (target == 0 && amount > 0.0001f)
+        if (target == 0 && c.lfoOn)
         {
             const float depthSemis = 12.0f * amount;
-            const float ratio = semitoneRatio(lfoV * depthSemis);
+            const float ratio = semitoneRatio<M>(lfoV * depthSemis);
             baseHz = clampf(baseHz * ratio, 1.0f, 20000.0f);
             attackHz = clampf(attackHz * ratio, 1.0f, 20000.0f);
         }
@@ -392,13 +517,12 @@ struct Kick {
         phase += (2.0f * kPi) * freq / sr;
         if (phase >= 2.0f * kPi) phase -= 2.0f * kPi;
 
-        const float body = std::sinf(phase);
+        const float body = M::sin(phase);
 
         // tail: triangle (plus riche en harmoniques que sinus)
-        const float tailFreq = maxf(1.0f, baseFreq * clampf(tailFreqMul, 1.0f, 4.0f));
-        phaseTail += (2.0f * kPi) * tailFreq / sr;
+        phaseTail += c.tailInc;
         if (phaseTail >= 2.0f * kPi) phaseTail -= 2.0f * kPi;
-        const float tail = triangleFromPhase(phaseTail);
+        const float tail = triangleFromPhase<M>(phaseTail, c.tailDt);
 
         // click bruité (suit driveEnv pour taper au début)
         const float click = noise.white() * clickGain * drive;
@@ -407,70 +531,208 @@ struct Kick {
         const float sub = subLP.process(body * amp);
 
         // Modulation Drive
-        float driveAmt = driveAmount;
-        if (target == 1 && amount > 0.0001f)
+        float driveAmt = c.driveAmount;
+        if (target == 1 && c.lfoOn)
         {
             const float m = 1.0f + 0.75f * amount * lfoV;
             driveAmt = clampf(driveAmt * m, 0.0f, 40.0f);
         }
 
         // Modulation Cutoff (postLP)
-        float postLp = postLpHz;
-        if (target == 2 && amount > 0.0001f)
+        if (target == 2 && c.lfoOn)
         {
             const float depthSemis = 24.0f * amount; // +/- 2 octaves à amount=1
-            const float ratio = semitoneRatio(lfoV * depthSemis);
-            postLp = clampf(postLp * ratio, 40.0f, 20000.0f);
-            postLP.setCutoff(postLp, srDist);
+            const float ratio = semitoneRatio<M>(lfoV * depthSemis);
+            const float postLp = clampf(postLpHz * ratio, 40.0f, 20000.0f);
+            postLP.setCutoff(postLp, c.srDist);
         }
 
         // Chemin "dirty": body + tail + click
-        float dirtyIn = (body * amp) + (tail * tailA * clampf(tailMix, 0.0f, 1.0f)) + click;
+        float dirtyIn = (body * amp) + (tail * tailA * c.tailMix) + click;
 
         // Layers ajoutés avant disto
         const float phaseMod = (target == 3) ? (lfoV * amount * kPi) : 0.0f;
 
-        dirtyIn += processLayer(layer1Env, phaseLayer1,
-                    layer1Enabled, layer1Type, layer1FreqHz,
-                    layer1Vol, layer1Drive,
-                    layer1AttackCoeff, layer1DecayCoeff,
-                sr, phaseMod);
-        dirtyIn += processLayer(layer2Env, phaseLayer2,
-                    layer2Enabled, layer2Type, layer2FreqHz,
-                    layer2Vol, layer2Drive,
-                    layer2AttackCoeff, layer2DecayCoeff,
-                sr, phaseMod);
+        dirtyIn += processLayer<M>(layer1Env, phaseLayer1, c.layer1, phaseMod);
+        dirtyIn += processLayer<M>(layer2Env, phaseLayer2, c.layer2, phaseMod);
         dirtyIn = preHP.process(dirtyIn);
 
         // drive commun (modulé par env) + feedback
-        const float fb = clampf(feedback, 0.0f, 0.5f);
         const float driveK = 1.0f + drive * driveAmt;
-        const float xDrive = (dirtyIn + fbZ * fb) * driveK;
+        const float xDrive = (dirtyIn + fbZ * c.feedback) * driveK;
 
         float dirty = 0.0f;
-        if (oversample2x)
+        if (os.factor() > 1)
         {
-            dirty = os2x.process(xDrive, [this](float xs) {
-                return processDirtyPath(xs);
+            dirty = os.process(xDrive, [this, &c](float xs) {
+                return processDirtyPath<M>(xs, c);
             });
         }
         else
         {
-            dirty = processDirtyPath(xDrive);
+            dirty = processDirtyPath<M>(xDrive, c);
         }
 
         // mix final
-        const float sm = clampf(subMix, 0.0f, 1.0f);
+        const float sm = c.subMix;
         float x = sub * sm + dirty * (1.0f - sm);
 
         // sortie
-        x = softClip(x) * postGain;
+        x = softClip(x) * c.postGain;
 
         if (!ampEnv.isActive() && !layer1Env.isActive() && !layer2Env.isActive())
             active = false;
 
         return x;
     }
+
+    float process(float sr) {
+        if (!active) return 0.0f;
+
+        BlockConsts c = makeBlockConsts(sr);
+        c.driveAmount = driveSm_.next();
+        c.postGain = postGainSm_.next();
+        return (mathMode == MathMode::Reference) ? renderSample<MathReference>(c)
+                                                 : renderSample<MathFast>(c);
+    }
+
+    // Coup rendu à l'identique : pas de LFO (ni cutoff encore modulé), pas de lissage en cours
+    bool isCacheable() const
+    {
+        return lfoAmount <= 0.0001f && !postLpModulated
+            && !driveSm_.isSmoothing() && !postGainSm_.isSmoothing();
+    }
+
+    // Fin de fondu (VoicePool) : voix coupée, lecture rendue, enregistrement en cours perdu
+    void stop()
+    {
+        detachCache();
+        active = false;
+    }
+
+    void detachCache()
+    {
+        if (cacheRec_ && cacheRec_->gen == cacheRecGen_)
+            cacheRec_->abort();
+        cacheRec_ = nullptr;
+        endCachePlayback();
+    }
+
+    void endCachePlayback()
+    {
+        if (cacheRead_)
+            --cacheRead_->readers;
+        cacheRead_ = nullptr;
+    }
+
+    // Appelés par KickCache::attach() juste après trigger()
+    void startCachePlayback(KickCacheSlot& slot, float gain)
+    {
+        ++slot.readers;
+        cacheRead_ = &slot;
+        cacheLen_ = slot.len;
+        cachePos_ = 0;
+        cacheGain_ = gain;
+    }
+
+    void startCacheRecording(KickCacheSlot& slot)
+    {
+        cacheRec_ = &slot;
+        cacheRecGen_ = slot.gen;
+    }
+
+    // Rendu d'un bloc mono (écrit dst[0..n), zéros une fois la voix éteinte).
+    void processBlock(float* dst, int n)
+    {
+        int i = 0;
+        if (active && cacheRead_)
+        {
+            i = playCache(dst, n);
+        }
+        else if (active)
+        {
+            const BlockConsts c = makeBlockConsts(sr_);
+            if (mathMode == MathMode::Reference)
+                i = renderBlock<MathReference>(dst, n, c);
+            else
+                i = renderBlock<MathFast>(dst, n, c);
+
+            if (cacheRec_)
+                recordCache(dst, i);
+        }
+        for (; i < n; ++i)
+            dst[i] = 0.0f;
+    }
+
+    int playCache(float* dst, int n)
+    {
+        int m = cacheLen_ - cachePos_;
+        if (m > n)
+            m = n;
+
+        const float* src = cacheRead_->buf + cachePos_;
+        const float g = cacheGain_;
+        for (int i = 0; i < m; ++i)
+            dst[i] = src[i] * g;
+
+        cachePos_ += m;
+        if (cachePos_ >= cacheLen_)
+        {
+            active = false;
+            endCachePlayback();
+        }
+        return m;
+    }
+
+    // Ajoute les n samples live au slot ; le coup complet le rend Ready.
+    void recordCache(const float* src, int n)
+    {
+        KickCacheSlot& s = *cacheRec_;
+        if (s.gen != cacheRecGen_ || s.state != KickCacheSlot::Recording)
+        {
+            cacheRec_ = nullptr; // invalidé (params) ou repris
+            return;
+        }
+
+        if (s.len + n > s.cap)
+        {
+            s.abort(); // coup trop long pour le cache : reste en live
+            cacheRec_ = nullptr;
+            return;
+        }
+
+        float* d = s.buf + s.len;
+        for (int i = 0; i < n; ++i)
+            d[i] = src[i];
+        s.len += n;
+
+        if (!active)
+        {
+            s.state = KickCacheSlot::Ready;
+            cacheRec_ = nullptr;
+        }
+    }
+
+    // Rend tant que la voix est active, renvoie le nombre de samples écrits.
+    template <typename M>
+    int renderBlock(float* dst, int n, BlockConsts c)
+    {
+        int i = 0;
+        if (driveSm_.isSmoothing() || postGainSm_.isSmoothing())
+        {
+            for (; i < n && active; ++i)
+            {
+                c.driveAmount = driveSm_.next();
+                c.postGain = postGainSm_.next();
+                dst[i] = renderSample<M>(c);
+            }
+            return i;
+        }
+
+        for (; i < n && active; ++i)
+            dst[i] = renderSample<M>(c);
+        return i;
+    }
 };
 
 } // namespace drumbox_core
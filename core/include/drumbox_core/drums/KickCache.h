@@ -0,0 +1,129 @@
+// Drumbox/core/include/drumbox_core/drums/KickCache.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+#include <cmath>
+#include <memory>
+
+namespace drumbox_core {
+
+// Couche de vélocité du cache : un coup de kick complet, rendu une fois.
+// gen change à chaque invalidation : une voix qui enregistre avec une gen périmée s'arrête.
+// readers : voix qui lisent encore buf ; la couche n'est pas réenregistrée tant qu'il en reste.
+struct KickCacheSlot
+{
+    enum State { Empty, Recording, Ready };
+
+    float* buf = nullptr;
+    int    cap = 0;
+    int    len = 0;
+    float  vel = 0.0f;
+    u32    gen = 0;
+    u64    lastUse = 0;
+    State  state = Empty;
+    int    readers = 0;
+
+    void abort()
+    {
+        state = Empty;
+        len = 0;
+        ++gen;
+    }
+};
+
+// Cache de coups pré-rendus pour des réglages de kick statiques.
+// Le premier coup à une vélocité donnée est rendu en live et enregistré dans une couche ;
+// les coups suivants à la même vélocité ne sont qu'une lecture de buffer.
+// Toute modif de paramètre kick invalide les couches ; pas de cache si le LFO est actif.
+// Seule différence avec le live : le bruit du click ne varie plus d'un coup à l'autre.
+class KickCache
+{
+public:
+    static constexpr int kLayers = 4;
+
+    // Non temps réel : maxSeconds de kick par couche, 0 = cache désactivé (aucune mémoire).
+    void prepare(double sr, float maxSeconds)
+    {
+        const int cap = (maxSeconds > 0.0f) ? (int)std::ceil(sr * (double)maxSeconds) : 0;
+        if (cap != cap_)
+        {
+            mem_.reset(cap > 0 ? new float[(size_t)cap * kLayers] : nullptr);
+            cap_ = cap;
+        }
+
+        for (int i = 0; i < kLayers; ++i)
+        {
+            slots_[i].buf = mem_ ? mem_.get() + (size_t)cap_ * (size_t)i : nullptr;
+            slots_[i].cap = cap_;
+            slots_[i].readers = 0; // les voix sont préparées en même temps
+        }
+        invalidate();
+    }
+
+    bool enabled() const { return cap_ > 0; }
+    size_t memoryBytes() const { return (size_t)cap_ * kLayers * sizeof(float); }
+
+    // Les voix en lecture finissent sur l'ancien buffer : readers reste compté, la couche
+    // n'est reprise pour un enregistrement qu'une fois toutes ces lectures terminées.
+    void invalidate()
+    {
+        for (int i = 0; i < kLayers; ++i)
+        {
+            slots_[i].state = KickCacheSlot::Empty;
+            slots_[i].len = 0;
+            ++slots_[i].gen;
+        }
+    }
+
+    // Après voice.trigger(vel) : lecture si une couche correspond, sinon enregistrement
+    // dans une couche libre (ou la moins récemment utilisée) sans lecteur. cacheable = false
+    // ou toutes les couches occupées -> live.
+    template <typename Voice>
+    void attach(Voice& voice, float vel, bool cacheable)
+    {
+        if (!enabled() || !cacheable || vel <= 0.0f)
+            return;
+
+        ++counter_;
+
+        KickCacheSlot* victim = nullptr;
+        for (int i = 0; i < kLayers; ++i)
+        {
+            KickCacheSlot& s = slots_[i];
+            if (s.state == KickCacheSlot::Ready && std::fabs(s.vel - vel) <= kVelTolerance)
+            {
+                s.lastUse = counter_;
+                voice.startCachePlayback(s, vel / s.vel);
+                return;
+            }
+
+            // une couche en cours d'enregistrement ou encore lue n'est jamais reprise
+            if (s.state == KickCacheSlot::Recording || s.readers > 0)
+                continue;
+            if (!victim || (victim->state == KickCacheSlot::Ready
+                            && (s.state == KickCacheSlot::Empty || s.lastUse < victim->lastUse)))
+                victim = &s;
+        }
+
+        if (!victim)
+            return;
+
+        victim->state = KickCacheSlot::Recording;
+        victim->len = 0;
+        victim->vel = vel;
+        victim->lastUse = counter_;
+        ++victim->gen;
+        voice.startCacheRecording(*victim);
+    }
+
+private:
+    // vélocités considérées identiques (un pas MIDI), corrigées par un gain vel / vel couche
+    static constexpr float kVelTolerance = 0.5f / 127.0f;
+
+    std::unique_ptr<float[]> mem_;
+    int cap_ = 0;
+    u64 counter_ = 0;
+    KickCacheSlot slots_[kLayers]{};
+};
+
+} // namespace drumbox_core
@@ -17,12 +17,18 @@ struct Snare {
     float toneFreq = 180.0f;  // Hz
     float noiseMix = 0.75f;   // 0..1
 
-    void prepare(double /*sr*/) {
+    float sr_ = 48000.0f;
+
+    void prepare(double sr) {
+        sr_ = (float)sr;
         ampEnv.setDecay(0.9975f);
         toneEnv.setDecay(0.993f);
         noise.seed(0xBEEF1234u);
     }
 
+    void reseed(u32 salt) { noise.seed(noise.state ^ salt); }
+    void stop() { active = false; }
+
     void trigger(float vel) {
         active = true;
         ampEnv.trigger(vel);
@@ -39,7 +45,7 @@ struct Snare {
         tonePhase += (2.0f * kPi) * toneFreq / sr;
         if (tonePhase > 2.0f * kPi) tonePhase -= 2.0f * kPi;
 
-        const float tone = t * std::sinf(tonePhase);
+        const float tone = t * std::sin(tonePhase);
         const float n = noise.white();
 
         float out = amp * (noiseMix * n + (1.0f - noiseMix) * tone);
@@ -47,6 +53,34 @@ struct Snare {
         if (!ampEnv.isActive()) active = false;
         return out;
     }
+
+    // Rendu d'un bloc mono (écrit dst[0..n), zéros une fois la voix éteinte).
+    void processBlock(float* dst, int n) {
+        int i = 0;
+        if (active)
+        {
+            const float inc = (2.0f * kPi) * toneFreq / sr_;
+            const float mixN = noiseMix;
+            const float mixT = 1.0f - noiseMix;
+            for (; i < n && active; ++i)
+            {
+                const float amp = ampEnv.process();
+                const float t = toneEnv.process();
+
+                tonePhase += inc;
+                if (tonePhase > 2.0f * kPi) tonePhase -= 2.0f * kPi;
+
+                const float tone = t * std::sin(tonePhase);
+                const float nz = noise.white();
+
+                dst[i] = amp * (mixN * nz + mixT * tone);
+
+                if (!ampEnv.isActive()) active = false;
+            }
+        }
+        for (; i < n; ++i)
+            dst[i] = 0.0f;
+    }
 };
 
 } // namespace drumbox_core
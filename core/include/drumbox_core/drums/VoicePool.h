@@ -0,0 +1,182 @@
+// Drumbox/core/include/drumbox_core/drums/VoicePool.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+
+namespace drumbox_core {
+
+// Pool de voix fixe (pas d'alloc) pour une lane.
+// - retrigger = nouvelle voix : la queue du coup précédent continue
+// - pool plein : la voix la plus ancienne est volée ; elle finit en fondu (declick)
+//   dans son propre objet, le nouveau coup part sur un objet libre
+// - F fondus simultanés (vols rapprochés) ; au-delà, le fondu le plus avancé est coupé
+// - liste dense des voix actives : les voix éteintes ne coûtent rien
+//
+// Les voix sont rendues l'une après l'autre (pas de lot SoA) : l'état d'une voix de kick
+// est une chaîne complète (filtres, oversampling, layers) et il y en a rarement plus d'une
+// ou deux actives par lane.
+//
+// Voice doit fournir prepare(sr), trigger(vel), processBlock(dst, n), reseed(salt),
+// stop() (coupe la voix et libère ce qu'elle tient) et un membre bool active.
+template <typename Voice, int N, int F = 2>
+struct VoicePool
+{
+    static_assert(N >= 1, "VoicePool: N >= 1");
+    static_assert(F >= 1, "VoicePool: F >= 1");
+
+    void prepare(double sr)
+    {
+        for (int i = 0; i < kObjects; ++i)
+        {
+            voices_[i].prepare(sr);
+            voices_[i].active = false;
+            // bruit décorrélé entre voix (la voix 0 garde la seed d'origine)
+            if (i > 0)
+                voices_[i].reseed(0x9E3779B9u * (u32)i);
+            order_[i] = 0;
+            fading_[i] = false;
+        }
+
+        numActive_ = 0;
+        numFades_ = 0;
+        counter_ = 0;
+
+        fadeLen_ = (int)(sr * 0.003); // ~3 ms
+        if (fadeLen_ < 1) fadeLen_ = 1;
+    }
+
+    // Applique fn à toutes les voix, y compris celles en fondu (params).
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for (int i = 0; i < kObjects; ++i)
+            fn(voices_[i]);
+    }
+
+    Voice& trigger(float vel)
+    {
+        if (numActive_ == N)
+        {
+            // vol de la plus ancienne : elle passe en fondu, sa place dans active_ est reprise
+            int a = 0;
+            for (int k = 1; k < numActive_; ++k)
+                if (order_[active_[k]] < order_[active_[a]])
+                    a = k;
+
+            startFade(active_[a]);
+            active_[a] = active_[--numActive_];
+        }
+
+        // objet libre : le plus bas (hits isolés => toujours la voix 0)
+        int idx = 0;
+        while (voices_[idx].active || fading_[idx])
+            ++idx; // N - 1 voix actives + F fondus au plus : il en reste un
+
+        active_[numActive_++] = idx;
+        Voice& v = voices_[idx];
+        order_[idx] = ++counter_;
+        v.trigger(vel);
+        return v;
+    }
+
+    // Somme des voix actives dans dst[0..n) ; tmp : buffer de travail de n floats.
+    void processBlock(float* dst, float* tmp, int n)
+    {
+        bool written = false;
+
+        for (int a = 0; a < numActive_;)
+        {
+            Voice& v = voices_[active_[a]];
+            if (!written)
+            {
+                v.processBlock(dst, n);
+                written = true;
+            }
+            else
+            {
+                v.processBlock(tmp, n);
+                for (int i = 0; i < n; ++i)
+                    dst[i] += tmp[i];
+            }
+
+            if (!v.active)
+                active_[a] = active_[--numActive_]; // retrait sans trou
+            else
+                ++a;
+        }
+
+        if (!written)
+        {
+            for (int i = 0; i < n; ++i)
+                dst[i] = 0.0f;
+        }
+
+        const float step = 1.0f / (float)fadeLen_;
+        for (int f = 0; f < numFades_;)
+        {
+            Fade& fd = fades_[f];
+            Voice& v = voices_[fd.voice];
+            if (v.active)
+            {
+                v.processBlock(tmp, n);
+                int i = 0;
+                for (; i < n && fd.pos < fadeLen_; ++i, ++fd.pos)
+                    dst[i] += tmp[i] * (1.0f - (float)fd.pos * step);
+            }
+
+            if (!v.active || fd.pos >= fadeLen_)
+                endFade(f);
+            else
+                ++f;
+        }
+    }
+
+    int numActive() const { return numActive_; }
+    bool isActive() const { return numActive_ > 0 || numFades_ > 0; }
+
+private:
+    static constexpr int kObjects = N + F;
+
+    struct Fade
+    {
+        int voice = 0;
+        int pos = 0;
+    };
+
+    void startFade(int idx)
+    {
+        if (numFades_ == F)
+        {
+            // plus de slot : on coupe le fondu le plus avancé (le moins audible)
+            int oldest = 0;
+            for (int f = 1; f < numFades_; ++f)
+                if (fades_[f].pos > fades_[oldest].pos)
+                    oldest = f;
+            endFade(oldest);
+        }
+
+        fading_[idx] = true;
+        fades_[numFades_++] = Fade{ idx, 0 };
+    }
+
+    void endFade(int f)
+    {
+        const int idx = fades_[f].voice;
+        voices_[idx].stop();
+        fading_[idx] = false;
+        fades_[f] = fades_[--numFades_];
+    }
+
+    Voice voices_[kObjects]{};
+    u64   order_[kObjects]{};   // ordre de déclenchement (vol de la plus ancienne)
+    bool  fading_[kObjects]{};  // objet en fondu (ni actif ni libre)
+    int   active_[N]{};         // indices des voix actives (dense)
+    int   numActive_ = 0;
+    u64   counter_ = 0;
+
+    Fade  fades_[F]{};
+    int   numFades_ = 0;
+    int   fadeLen_ = 1;
+};
+
+} // namespace drumbox_core
@@ -1,19 +1,31 @@
 // Drumbox/core/include/drumbox_core/dsp/AllpassDelay.h
 
 #pragma once
+#include "drumbox_core/dsp/DelayArena.h"
+#include "drumbox_core/dsp/Denormals.h"
 
 namespace drumbox_core {
 
-template <int N>
+// Allpass à retard ; le buffer est fourni par une DelayArena (taille fixée au prepare).
 struct AllpassDelay
 {
-    float buf[N]{};
+    float* buf = nullptr;
+    int size = 0;
     int idx = 0;
     float feedback = 0.5f; // 0..0.9 typique
 
+    // false si l'arena est pleine (ligne inutilisable)
+    bool attach(DelayArena& arena, int n)
+    {
+        buf = arena.take(n);
+        size = buf ? n : 0;
+        reset();
+        return buf != nullptr;
+    }
+
     void reset()
     {
-        for (int i = 0; i < N; ++i) buf[i] = 0.0f;
+        for (int i = 0; i < size; ++i) buf[i] = 0.0f;
         idx = 0;
     }
 
@@ -21,8 +33,8 @@ struct AllpassDelay
     {
         const float b = buf[idx];
         const float y = -x + b;
-        buf[idx] = x + b * feedback;
-        if (++idx >= N) idx = 0;
+        buf[idx] = flushDenormal(x + b * feedback);
+        if (++idx >= size) idx = 0;
         return y;
     }
 };
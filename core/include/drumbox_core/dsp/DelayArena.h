@@ -0,0 +1,57 @@
+// Drumbox/core/include/drumbox_core/dsp/DelayArena.h
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <memory>
+
+namespace drumbox_core {
+
+// Longueur d'une ligne à retard donnée en samples à 48 kHz, ramenée au sample rate
+// (même taille de pièce quel que soit le sr ; identique à 48 kHz).
+inline int scaleDelay(int samplesAt48k, float sampleRate)
+{
+    const int n = (int)std::lround((double)samplesAt48k * (double)sampleRate / 48000.0);
+    return (n > 1) ? n : 1;
+}
+
+// Mémoire des lignes à retard d'une Engine : un seul bloc alloué hors thread audio,
+// découpé à la suite par les étages dans leur prepare().
+// reserve() puis take() pour chaque ligne ; rien n'est libéré individuellement.
+class DelayArena
+{
+public:
+    // Non temps réel. Réalloue seulement si la taille change ; 0 = aucune mémoire.
+    void reserve(size_t numFloats)
+    {
+        if (numFloats != capacity_)
+        {
+            mem_.reset(numFloats > 0 ? new float[numFloats] : nullptr);
+            capacity_ = numFloats;
+        }
+        used_ = 0;
+    }
+
+    // Ligne de n floats (mise à zéro), nullptr si l'arena est trop petite.
+    float* take(int n)
+    {
+        if (n <= 0 || used_ + (size_t)n > capacity_)
+            return nullptr;
+
+        float* p = mem_.get() + used_;
+        used_ += (size_t)n;
+        for (int i = 0; i < n; ++i)
+            p[i] = 0.0f;
+        return p;
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t used() const { return used_; }
+
+private:
+    std::unique_ptr<float[]> mem_;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+};
+
+} // namespace drumbox_core
@@ -0,0 +1,64 @@
+// Drumbox/core/include/drumbox_core/dsp/Denormals.h
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+  #include <xmmintrin.h>
+  #define DRUMBOX_DENORMALS_MXCSR 1
+#elif defined(__aarch64__)
+  #define DRUMBOX_DENORMALS_FPCR 1
+#endif
+
+namespace drumbox_core {
+
+// Stratégie dénormaux :
+// - ScopedNoDenormals autour du rendu (Engine::process) : FTZ/DAZ matériel
+// - flushDenormal() dans les boucles récursives (enveloppes, one-pole, comb/allpass),
+//   pour rester sûr quand une brique est utilisée hors de l'Engine
+//   (bench, outils, autre thread sans garde).
+
+// sous ce niveau (~ -300 dB) un état récursif est remis à zéro,
+// bien avant d'atteindre les sous-normaux (~1e-38)
+constexpr float kDenormalFloor = 1.0e-15f;
+
+inline float flushDenormal(float x)
+{
+    return (std::fabs(x) < kDenormalFloor) ? 0.0f : x;
+}
+
+// Active flush-to-zero / denormals-are-zero pour la portée courante
+// et restaure l'état précédent à la sortie (le thread appelant ne nous appartient pas).
+struct ScopedNoDenormals
+{
+    ScopedNoDenormals() noexcept
+    {
+#if defined(DRUMBOX_DENORMALS_MXCSR)
+        prev_ = _mm_getcsr();
+        _mm_setcsr(prev_ | 0x8040u); // FTZ (bit 15) | DAZ (bit 6)
+#elif defined(DRUMBOX_DENORMALS_FPCR)
+        uint64_t fpcr = 0;
+        asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+        prev_ = fpcr;
+        asm volatile("msr fpcr, %0" : : "r"(fpcr | (1ull << 24))); // FZ
+#endif
+    }
+
+    ~ScopedNoDenormals()
+    {
+#if defined(DRUMBOX_DENORMALS_MXCSR)
+        _mm_setcsr((unsigned int)prev_);
+#elif defined(DRUMBOX_DENORMALS_FPCR)
+        asm volatile("msr fpcr, %0" : : "r"(prev_));
+#endif
+    }
+
+    ScopedNoDenormals(const ScopedNoDenormals&) = delete;
+    ScopedNoDenormals& operator=(const ScopedNoDenormals&) = delete;
+
+private:
+    uint64_t prev_ = 0;
+};
+
+} // namespace drumbox_core
@@ -1,6 +1,7 @@
 // Drumbox/core/include/drumbox_core/dsp/EnvelopeExp.h
 
 #pragma once
+#include "drumbox_core/dsp/Denormals.h"
 #include <cmath>
 
 namespace drumbox_core {
@@ -14,7 +15,7 @@ struct EnvelopeExp {
 
     float process() {
         float out = value;
-        value *= decay;
+        value = flushDenormal(value * decay); // décroît sans fin : coupé avant les sous-normaux
         return out;
     }
 
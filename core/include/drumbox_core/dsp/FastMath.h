@@ -0,0 +1,146 @@
+// Drumbox/core/include/drumbox_core/dsp/FastMath.h
+
+#pragma once
+#include "drumbox_core/Types.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace drumbox_core {
+
+// Backends mathématiques interchangeables (sin, tanh, exp2, floor, foldback).
+// - MathFast      : table / rationnel / polynôme, erreur bornée (voir chaque fonction)
+// - MathReference : libm, pour comparaison A/B
+// Les voix sont templatées dessus : le choix se fait une fois par bloc, pas par sample.
+
+enum class MathMode : int
+{
+    Fast = 0,
+    Reference = 1
+};
+
+namespace fastmath {
+
+constexpr int kSineTableBits = 11;
+constexpr int kSineTableSize = 1 << kSineTableBits; // 2048 points / période
+
+struct SineTable
+{
+    float v[kSineTableSize + 1]; // +1 : garde pour l'interpolation
+
+    SineTable()
+    {
+        for (int i = 0; i <= kSineTableSize; ++i)
+            v[i] = (float)std::sin(2.0 * 3.14159265358979323846 * (double)i / (double)kSineTableSize);
+    }
+};
+
+// Construite une seule fois au chargement (variable inline C++17).
+inline const SineTable kSineTable{};
+
+// floor sans branche ni appel libm (|x| < 2^31)
+inline float floor(float x)
+{
+    const float t = (float)(int)x;
+    return t - ((t > x) ? 1.0f : 0.0f);
+}
+
+// sin(phase), phase en radians dans [0, 2pi).
+// Table 2048 points + interpolation linéaire : |erreur| < 2e-6.
+inline float sin(float phaseRad)
+{
+    const float pos = phaseRad * ((float)kSineTableSize / (2.0f * kPi));
+    const int i = (int)pos;
+    const float frac = pos - (float)i;
+    const int idx = i & (kSineTableSize - 1); // hors domaine : reste dans la table
+    const float a = kSineTable.v[idx];
+    const float b = kSineTable.v[idx + 1];
+    return a + (b - a) * frac;
+}
+
+// tanh : fraction continue de Lambert (7/6), saturée à +/-1.
+// |erreur| < 1e-4 (max vers |x| ~ 5), < 1e-6 pour |x| < 2.5.
+inline float tanh(float x)
+{
+    const float xc = (x < -4.97f) ? -4.97f : ((x > 4.97f) ? 4.97f : x);
+    const float x2 = xc * xc;
+    const float num = xc * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+    const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+    const float y = num / den;
+    return (y < -1.0f) ? -1.0f : ((y > 1.0f) ? 1.0f : y);
+}
+
+// 2^x : exposant injecté dans les bits du float + polynôme degré 5 sur la partie fractionnaire.
+// Erreur relative < 2e-7 sur [-126, 126].
+inline float exp2(float x)
+{
+    const float xc = (x < -126.0f) ? -126.0f : ((x > 126.0f) ? 126.0f : x);
+    const float xi = floor(xc);
+    const float f = xc - xi;
+
+    const float p = 0.999999898f
+                  + f * (0.69315449f
+                  + f * (0.240141818f
+                  + f * (0.0558603371f
+                  + f * (0.00894959042f
+                  + f * 0.00189375406f))));
+
+    const u32 bits = (u32)((int)xi + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// Foldback sans fmod ni branchement de repli (même courbe que la version de référence).
+inline float foldback(float x, float threshold)
+{
+    if (threshold <= 0.0f) return 0.0f;
+    const float t2 = threshold * 2.0f;
+    const float t4 = threshold * 4.0f;
+
+    // (x - t) mod 4t, puis triangle
+    const float u = (x - threshold) / t4;
+    float y = (u - floor(u)) * t4;
+    y = t2 - std::fabs(y - t2);
+    y -= threshold;
+
+    const bool outside = (x > threshold) || (x < -threshold);
+    return outside ? y : x;
+}
+
+} // namespace fastmath
+
+struct MathFast
+{
+    static inline float sin(float phaseRad) { return fastmath::sin(phaseRad); }
+    static inline float tanh(float x) { return fastmath::tanh(x); }
+    static inline float exp2(float x) { return fastmath::exp2(x); }
+    static inline float floor(float x) { return fastmath::floor(x); }
+    static inline float foldback(float x, float threshold) { return fastmath::foldback(x, threshold); }
+};
+
+struct MathReference
+{
+    static inline float sin(float phaseRad) { return std::sin(phaseRad); }
+    static inline float tanh(float x) { return std::tanh(x); }
+    static inline float exp2(float x) { return std::pow(2.0f, x); }
+    static inline float floor(float x) { return std::floor(x); }
+
+    static inline float foldback(float x, float threshold)
+    {
+        if (threshold <= 0.0f) return 0.0f;
+        const float t2 = threshold * 2.0f;
+        const float t4 = threshold * 4.0f;
+
+        if (x > threshold || x < -threshold) {
+            float y = std::fmod(x - threshold, t4);
+            if (y < 0.0f) y += t4;
+            if (y > t2) y = t4 - y;
+            y -= threshold;
+            return y;
+        }
+        return x;
+    }
+};
+
+} // namespace drumbox_core
@@ -7,6 +7,9 @@
 #include "drumbox_core/dsp/OnePole.h"
 #include "drumbox_core/dsp/Ott3Band.h"
 #include "drumbox_core/dsp/Saturation.h"
+#include "drumbox_core/dsp/SilenceDetector.h"
+#include "drumbox_core/dsp/Simd.h"
+#include "drumbox_core/dsp/Smoother.h"
 
 #include <algorithm>
 #include <cmath>
@@ -16,13 +19,45 @@ namespace drumbox_core {
 // FX section comprenant :
 // - Disperse: petit diffuseur all-pass (donne du smear/transient spread)
 // - Inflator: drive + soft clip + mix
+// Les allpass du diffuseur prennent leurs buffers dans une DelayArena.
 struct FxSection
 {
-    void prepare(float sampleRate)
+    // Mémoire nécessaire (en floats) pour ce sample rate
+    static size_t requiredFloats(float sampleRate)
+    {
+        const float sr = (sampleRate > 8000.0f) ? sampleRate : 8000.0f;
+        size_t n = 0;
+        for (int len : kApL) n += (size_t)scaleDelay(len, sr);
+        for (int len : kApR) n += (size_t)scaleDelay(len, sr);
+        return n;
+    }
+
+    // Non temps réel. Arena trop petite => diffuseur inactif.
+    void prepare(float sampleRate, DelayArena& arena)
     {
         sampleRate_ = (sampleRate > 8000.0f) ? sampleRate : 8000.0f;
+
+        AllpassDelay* l[4] = { &apL0, &apL1, &apL2, &apL3 };
+        AllpassDelay* r[4] = { &apR0, &apR1, &apR2, &apR3 };
+        disperseReady_ = true;
+        for (int k = 0; k < 4; ++k)
+        {
+            disperseReady_ &= l[k]->attach(arena, scaleDelay(kApL[k], sampleRate_));
+            disperseReady_ &= r[k]->attach(arena, scaleDelay(kApR[k], sampleRate_));
+        }
+
         shifter_.prepare(sampleRate);
         ott_.prepare(sampleRate);
+
+        // mixes lissés (~20 ms) : pas de zipper quand on tourne un bouton
+        stereo_.prepare(sampleRate_, kSmoothMs);
+        disperseMix_.prepare(sampleRate_, kSmoothMs);
+        inflatorAmt_.prepare(sampleRate_, kSmoothMs);
+        inflatorMix_.prepare(sampleRate_, kSmoothMs);
+        cleanDirty_.prepare(sampleRate_, kSmoothMs);
+
+        // ~100 ms : couvre les diffuseurs et le release de l'OTT
+        silence_.prepare((int)(sampleRate_ * 0.1f));
         reset();
     }
 
@@ -34,11 +69,14 @@ struct FxSection
         env_.value = 0.0f;
         env_.stage = EnvelopeADExp::Off;
         envVel_ = 1.0f;
-        toneLP_L.reset();
-        toneLP_R.reset();
+        toneZ_ = F4(0.0f);
         ott_.reset();
+        silence_.reset();
     }
 
+    // Plus de queue (suivi fait par processBlock) : sortie nulle tant que l'entrée l'est.
+    bool isSilent() const { return silence_.isSilent(); }
+
     void setShiftHz(float hz)
     {
         shiftHz_ = std::clamp(hz, -2000.0f, 2000.0f);
@@ -47,7 +85,7 @@ struct FxSection
 
     void setStereo(float amount)
     {
-        stereo_ = clamp01(amount);
+        stereo_.setTarget(clamp01(amount));
     }
 
     void setDiffusion(float amount)
@@ -60,7 +98,7 @@ struct FxSection
 
     void setCleanDirty(float amount)
     {
-        cleanDirty_ = clamp01(amount);
+        cleanDirty_.setTarget(clamp01(amount));
     }
 
     void setTone(float amount)
@@ -73,8 +111,9 @@ struct FxSection
         if (cutoff > nyq * 0.45f)
             cutoff = nyq * 0.45f;
 
-        toneLP_L.setCutoff(cutoff, sampleRate_);
-        toneLP_R.setCutoff(cutoff, sampleRate_);
+        OnePoleLP lp;
+        lp.setCutoff(cutoff, sampleRate_);
+        toneA_ = F4(lp.a);
     }
 
     void setEnv(float attackCoeff, float decayCoeff, float vol)
@@ -92,13 +131,13 @@ struct FxSection
 
     void setDisperse(float amount)
     {
-        disperseMix_ = clamp01(amount);
+        disperseMix_.setTarget(clamp01(amount));
     }
 
     void setInflator(float amount, float mix)
     {
-        inflatorAmt_ = clamp01(amount);
-        inflatorMix_ = clamp01(mix);
+        inflatorAmt_.setTarget(clamp01(amount));
+        inflatorMix_.setTarget(clamp01(mix));
     }
 
     void setOtt(float amount)
@@ -123,45 +162,47 @@ struct FxSection
         }
 
         // Stereo width (mid/side). Amount 0 = no-op.
-        if (stereo_ > 0.0001f)
+        const float st = stereo_.next();
+        if (st > 0.0001f)
         {
             const float mid = 0.5f * (xL + xR);
             float side = 0.5f * (xL - xR);
 
             // width goes from 1.0 to 2.0 (plus stable)
-            const float width = 1.0f + stereo_ * 1.0f;
+            const float width = 1.0f + st * 1.0f;
             side *= width;
 
             const float wL = mid + side;
             const float wR = mid - side;
 
             // blend to avoid huge level jumps
-            xL = xL * (1.0f - stereo_) + wL * stereo_;
-            xR = xR * (1.0f - stereo_) + wR * stereo_;
+            xL = xL * (1.0f - st) + wL * st;
+            xR = xR * (1.0f - st) + wR * st;
         }
 
         // Disperse (wet only)
         float dL = xL;
         float dR = xR;
-        if (disperseMix_ > 0.0001f)
+        const float dm = disperseMix_.next();
+        if (dm > 0.0001f && disperseReady_)
         {
             dL = apL3.process(apL2.process(apL1.process(apL0.process(dL))));
             dR = apR3.process(apR2.process(apR1.process(apR0.process(dR))));
 
             // crossfade dry/wet
-            xL = xL * (1.0f - disperseMix_) + dL * disperseMix_;
-            xR = xR * (1.0f - disperseMix_) + dR * disperseMix_;
+            xL = xL * (1.0f - dm) + dL * dm;
+            xR = xR * (1.0f - dm) + dR * dm;
         }
 
-        // Inflator (drive + soft clip + mix)
-        if (inflatorAmt_ > 0.0001f)
+        // Inflator (drive + soft clip + mix), L/R dans une paire de lanes
+        const float infAmt = inflatorAmt_.next();
+        const float infMix = inflatorMix_.next();
+        if (infAmt > 0.0001f)
         {
-            const float drive = 1.0f + inflatorAmt_ * 12.0f;
-            const float yL = softClip(xL * drive);
-            const float yR = softClip(xR * drive);
-            const float m = inflatorMix_;
-            xL = xL * (1.0f - m) + yL * m;
-            xR = xR * (1.0f - m) + yR * m;
+            const F4 x(xL, xR, 0.0f, 0.0f);
+            const F4 y = inflate(x, F4(1.0f + infAmt * 12.0f), F4(infMix));
+            xL = y.lane0();
+            xR = y.lane1();
         }
 
         // OTT (3 bandes)
@@ -186,48 +227,245 @@ struct FxSection
         // Tone (LP) en fin de chaîne FX
         if (tone_ < 0.999f)
         {
-            xL = toneLP_L.process(xL);
-            xR = toneLP_R.process(xR);
+            toneZ_ += toneA_ * (F4(xL, xR, 0.0f, 0.0f) - toneZ_);
+            xL = toneZ_.lane0();
+            xR = toneZ_.lane1();
         }
 
         // Clean/Dirty mix: 0=clean (bypass FX), 1=dirty (full FX)
-        const float m = cleanDirty_;
+        const float m = cleanDirty_.next();
         outL = dryL * (1.0f - m) + xL * m;
         outR = dryR * (1.0f - m) + xR * m;
     }
 
+    // Version bloc : chaque étage parcourt tout le bloc avant le suivant.
+    // in et out ne doivent pas se chevaucher (in sert de voie "clean").
+    void processBlock(const float* inL, const float* inR, float* outL, float* outR, int n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            outL[i] = inL[i];
+            outR[i] = inR[i];
+        }
+
+        // Frequency shifter (SSB-ish) : L et R partagent le même shifter, on garde l'ordre L/R par sample
+        if (std::abs(shiftHz_) > 0.001f)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                outL[i] = shifter_.process(outL[i]);
+                outR[i] = shifter_.process(outR[i]);
+            }
+        }
+
+        // Paramètres lissés : chemin constant (vectorisé) au repos,
+        // chemin par sample uniquement pendant une rampe.
+
+        // Stereo width (mid/side)
+        if (stereo_.isSmoothing())
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float st = stereo_.next();
+                const float xL = outL[i];
+                const float xR = outR[i];
+                const float mid = 0.5f * (xL + xR);
+                const float side = 0.5f * (xL - xR) * (1.0f + st * 1.0f);
+                outL[i] = xL * (1.0f - st) + (mid + side) * st;
+                outR[i] = xR * (1.0f - st) + (mid - side) * st;
+            }
+        }
+        else if (stereo_.current() > 0.0001f)
+        {
+            const float st = stereo_.current();
+            const float width = 1.0f + st * 1.0f;
+            mapStereo(outL, outR, outL, outR, n, [=](auto xL, auto xR, auto& oL, auto& oR) {
+                using T = decltype(xL);
+                const T mid = T(0.5f) * (xL + xR);
+                const T side = T(0.5f) * (xL - xR) * T(width);
+                oL = xL * T(1.0f - st) + (mid + side) * T(st);
+                oR = xR * T(1.0f - st) + (mid - side) * T(st);
+            });
+        }
+
+        // Disperse (wet only)
+        // (sans mémoire pour le diffuseur, l'étage est ignoré)
+        if (disperseReady_ && disperseMix_.isSmoothing())
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float m = disperseMix_.next();
+                const float dL = apL3.process(apL2.process(apL1.process(apL0.process(outL[i]))));
+                const float dR = apR3.process(apR2.process(apR1.process(apR0.process(outR[i]))));
+                outL[i] = outL[i] * (1.0f - m) + dL * m;
+                outR[i] = outR[i] * (1.0f - m) + dR * m;
+            }
+        }
+        else if (disperseReady_ && disperseMix_.current() > 0.0001f)
+        {
+            const float m = disperseMix_.current();
+            for (int i = 0; i < n; ++i)
+            {
+                const float d = apL3.process(apL2.process(apL1.process(apL0.process(outL[i]))));
+                outL[i] = outL[i] * (1.0f - m) + d * m;
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                const float d = apR3.process(apR2.process(apR1.process(apR0.process(outR[i]))));
+                outR[i] = outR[i] * (1.0f - m) + d * m;
+            }
+        }
+
+        // Inflator (drive + soft clip + mix)
+        if (inflatorAmt_.isSmoothing() || inflatorMix_.isSmoothing())
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float amt = inflatorAmt_.next();
+                const float mix = inflatorMix_.next();
+                if (amt <= 0.0001f)
+                    continue;
+                const F4 y = inflate(F4(outL[i], outR[i], 0.0f, 0.0f), F4(1.0f + amt * 12.0f), F4(mix));
+                outL[i] = y.lane0();
+                outR[i] = y.lane1();
+            }
+        }
+        else if (inflatorAmt_.current() > 0.0001f)
+        {
+            const F4 drive(1.0f + inflatorAmt_.current() * 12.0f);
+            const F4 m(inflatorMix_.current());
+            int i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                inflate(F4::load(outL + i), drive, m).store(outL + i);
+                inflate(F4::load(outR + i), drive, m).store(outR + i);
+            }
+            for (; i < n; ++i)
+            {
+                const F4 y = inflate(F4(outL[i], outR[i], 0.0f, 0.0f), drive, m);
+                outL[i] = y.lane0();
+                outR[i] = y.lane1();
+            }
+        }
+
+        // OTT (3 bandes)
+        if (ottAmount_ > 0.0001f)
+            ott_.processBlock(outL, outR, n);
+
+        // Envelope transient sur la voie FX
+        if (envVol_ > 0.0001f)
+        {
+            for (int i = 0; i < n && env_.isActive(); ++i)
+            {
+                const float e = std::clamp(env_.process(), 0.0f, 1.0f);
+                const float g = 1.0f + envVol_ * envVel_ * e;
+                outL[i] *= g;
+                outR[i] *= g;
+            }
+        }
+
+        // Tone (LP) en fin de chaîne FX
+        if (tone_ < 0.999f)
+        {
+            const F4 a = toneA_;
+            F4 z = toneZ_;
+            for (int i = 0; i < n; ++i)
+            {
+                z += a * (F4(outL[i], outR[i], 0.0f, 0.0f) - z);
+                outL[i] = z.lane0();
+                outR[i] = z.lane1();
+            }
+            toneZ_ = z;
+        }
+
+        // Clean/Dirty mix
+        if (cleanDirty_.isSmoothing())
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float m = cleanDirty_.next();
+                outL[i] = inL[i] * (1.0f - m) + outL[i] * m;
+                outR[i] = inR[i] * (1.0f - m) + outR[i] * m;
+            }
+        }
+        else
+        {
+            const float m = cleanDirty_.current();
+            mapStereo(inL, inR, outL, outR, n, [=](auto dL, auto dR, auto& xL, auto& xR) {
+                using T = decltype(dL);
+                xL = dL * T(1.0f - m) + xL * T(m);
+                xR = dR * T(1.0f - m) + xR * T(m);
+            });
+        }
+
+        // silence : entrée et sortie sous le seuil assez longtemps => état vidé
+        const float peak = std::max(SilenceDetector::peak(inL, inR, n), SilenceDetector::peak(outL, outR, n));
+        if (silence_.update(peak, n))
+            reset();
+    }
+
 private:
+    static constexpr float kSmoothMs = 20.0f;
+
     static inline float clamp01(float v) { return (v < 0.0f) ? 0.0f : ((v > 1.0f) ? 1.0f : v); }
 
-    // Delays fixes (pas d’alloc). Valeurs différentes L/R pour élargir.
-    AllpassDelay<113> apL0{};
-    AllpassDelay<151> apL1{};
-    AllpassDelay<197> apL2{};
-    AllpassDelay<269> apL3{};
+    static inline F4 inflate(F4 x, F4 drive, F4 mix)
+    {
+        return x * (F4(1.0f) - mix) + softClip(x * drive) * mix;
+    }
+
+    // op(aL, aR, xL, xR) par paquets de 4 samples (F4), puis le reste en scalaire.
+    // a* en lecture, x* en lecture/écriture (a et x peuvent être le même buffer).
+    template <typename Op>
+    static void mapStereo(const float* aL, const float* aR, float* xL, float* xR, int n, Op op)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            F4 l = F4::load(xL + i);
+            F4 r = F4::load(xR + i);
+            op(F4::load(aL + i), F4::load(aR + i), l, r);
+            l.store(xL + i);
+            r.store(xR + i);
+        }
+        for (; i < n; ++i)
+            op(aL[i], aR[i], xL[i], xR[i]);
+    }
+
+    // Longueurs en samples à 48 kHz. Valeurs différentes L/R pour élargir.
+    static constexpr int kApL[4] = { 113, 151, 197, 269 };
+    static constexpr int kApR[4] = { 127, 163, 211, 281 };
+
+    AllpassDelay apL0{};
+    AllpassDelay apL1{};
+    AllpassDelay apL2{};
+    AllpassDelay apL3{};
 
-    AllpassDelay<127> apR0{};
-    AllpassDelay<163> apR1{};
-    AllpassDelay<211> apR2{};
-    AllpassDelay<281> apR3{};
+    AllpassDelay apR0{};
+    AllpassDelay apR1{};
+    AllpassDelay apR2{};
+    AllpassDelay apR3{};
+    bool disperseReady_ = false;
 
     FreqShifter shifter_{};
-    OnePoleLP toneLP_L{};
-    OnePoleLP toneLP_R{};
+    F4 toneA_{ 0.0f };  // coeff du LP tone (L/R dans les lanes 0/1)
+    F4 toneZ_{ 0.0f };
 
     Ott3Band ott_{};
+    SilenceDetector silence_{};
 
     float sampleRate_ = 48000.0f;
     float shiftHz_ = 0.0f;
-    float stereo_ = 0.0f;
+    SmoothedValue stereo_{ 0.0f };
     float diffusion_ = 0.0f;
-    float cleanDirty_ = 1.0f;
+    SmoothedValue cleanDirty_{ 1.0f };
     float tone_ = 0.5f;
     EnvelopeADExp env_{};
     float envVol_ = 0.0f;
     float envVel_ = 1.0f;
-    float disperseMix_ = 0.0f;
-    float inflatorAmt_ = 0.0f;
-    float inflatorMix_ = 0.5f;
+    SmoothedValue disperseMix_{ 0.0f };
+    SmoothedValue inflatorAmt_{ 0.0f };
+    SmoothedValue inflatorMix_{ 0.5f };
     float ottAmount_ = 0.0f;
 };
 
@@ -0,0 +1,53 @@
+// Drumbox/core/include/drumbox_core/dsp/Interleave.h
+
+#pragma once
+#include "drumbox_core/dsp/Simd.h"
+
+namespace drumbox_core {
+
+// Planar -> interleaved pour les hosts qui veulent out[frame*ch + c].
+// Stéréo : 4 frames par itération (2 stores de 4 floats, pas d'écriture à pas fixe).
+// Copie pure : résultat identique à la boucle scalaire.
+inline void interleaveStereo(const float* l, const float* r, float* out, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        const F4 a = F4::load(l + i);
+        const F4 b = F4::load(r + i);
+        F4::zipLow(a, b).store(out + 2 * i);
+        F4::zipHigh(a, b).store(out + 2 * i + 4);
+    }
+    for (; i < n; ++i)
+    {
+        out[2 * i] = l[i];
+        out[2 * i + 1] = r[i];
+    }
+}
+
+// L/R vers numChannels canaux : mono = (L+R)/2, canaux au-delà de 2 = (L+R)/2
+inline void interleave(const float* l, const float* r, float* out, int n, int numChannels)
+{
+    if (numChannels == 2)
+    {
+        interleaveStereo(l, r, out, n);
+    }
+    else if (numChannels == 1)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = 0.5f * (l[i] + r[i]);
+    }
+    else
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            float* frame = out + i * numChannels;
+            frame[0] = l[i];
+            frame[1] = r[i];
+            for (int c = 2; c < numChannels; ++c)
+                frame[c] = 0.5f * (l[i] + r[i]);
+        }
+    }
+}
+
+} // namespace drumbox_core
@@ -47,7 +47,7 @@ struct Lfo {
             case 2: // square
                 return (phase01 < pulse01) ? 1.0f : -1.0f;
             default: // sine
-                return std::sinf(2.0f * 3.14159265358979323846f * phase01);
+                return std::sin(2.0f * 3.14159265358979323846f * phase01);
         }
     }
 };
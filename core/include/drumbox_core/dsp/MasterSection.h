@@ -3,6 +3,9 @@
 #pragma once
 #include "drumbox_core/dsp/OnePole.h"
 #include "drumbox_core/dsp/Saturation.h"
+#include "drumbox_core/dsp/SilenceDetector.h"
+#include "drumbox_core/dsp/Simd.h"
+#include "drumbox_core/dsp/Smoother.h"
 
 #include <algorithm>
 #include <cmath>
@@ -15,17 +18,20 @@ struct MasterSection
     {
         sr_ = (sampleRate > 8000.0f) ? sampleRate : 8000.0f;
         updateFilters();
+        gain_.prepare(sr_, 20.0f);
+        silence_.prepare((int)(sr_ * 0.01f));
         reset();
     }
 
     void reset()
     {
-        lowLP_L.reset();
-        lowLP_R.reset();
-        highHP_L.reset();
-        highHP_R.reset();
+        z_ = F4(0.0f);
+        silence_.reset();
     }
 
+    // Filtres retombés (suivi fait par le processBlock à gain lissé) : sortie nulle tant que l'entrée l'est.
+    bool isSilent() const { return silence_.isSilent(); }
+
     void setEqDb(float lowDb, float midDb, float highDb)
     {
         lowDb_ = std::clamp(lowDb, -24.0f, 24.0f);
@@ -37,6 +43,12 @@ struct MasterSection
         highG_ = dbToLin(highDb_);
     }
 
+    // gain de sortie lissé (utilisé par processBlock sans gainLin)
+    void setGain(float gainLin)
+    {
+        gain_.setTarget(gainLin);
+    }
+
     void setClipper(bool enabled, int mode)
     {
         clipOn_ = enabled;
@@ -45,50 +57,85 @@ struct MasterSection
 
     inline void process(float inL, float inR, float gainLin, float& outL, float& outR)
     {
-        // 3-bandes simple via split (LP/HP) + mid résiduel.
-        float lowL = lowLP_L.process(inL);
-        float highL = highHP_L.process(inL);
-        float midL = inL - lowL - highL;
+        const F4 y = tick(F4(inL, inR, inL, inR), F4(lowG_), F4(midG_), F4(highG_), F4(gainLin), clipKind());
+        outL = y.lane0();
+        outR = y.lane1();
+    }
 
-        float lowR = lowLP_R.process(inR);
-        float highR = highHP_R.process(inR);
-        float midR = inR - lowR - highR;
+    // Version bloc (in et out peuvent pointer sur le même buffer).
+    // L'état des filtres reste en registre pendant la boucle.
+    void processBlock(const float* inL, const float* inR, float gainLin,
+                      float* outL, float* outR, int n)
+    {
+        const F4 lowG(lowG_), midG(midG_), highG(highG_), gain(gainLin);
+        const int clip = clipKind();
 
-        float yL = lowL * lowG_ + midL * midG_ + highL * highG_;
-        float yR = lowR * lowG_ + midR * midG_ + highR * highG_;
+        for (int i = 0; i < n; ++i)
+        {
+            const float xL = inL[i];
+            const float xR = inR[i];
+            const F4 y = tick(F4(xL, xR, xL, xR), lowG, midG, highG, gain, clip);
+            outL[i] = y.lane0();
+            outR[i] = y.lane1();
+        }
+    }
 
-        yL *= gainLin;
-        yR *= gainLin;
+    // Version bloc avec le gain lissé de setGain().
+    void processBlock(const float* inL, const float* inR, float* outL, float* outR, int n)
+    {
+        const float inPeak = SilenceDetector::peak(inL, inR, n);
 
-        if (clipOn_)
+        if (!gain_.isSmoothing())
         {
-            switch (clipMode_)
+            processBlock(inL, inR, gain_.current(), outL, outR, n);
+        }
+        else
+        {
+            const F4 lowG(lowG_), midG(midG_), highG(highG_);
+            const int clip = clipKind();
+
+            for (int i = 0; i < n; ++i)
             {
-                default:
-                case 0: yL = softClip(yL); yR = softClip(yR); break;
-                case 1: yL = hardClip(yL); yR = hardClip(yR); break;
+                const float xL = inL[i];
+                const float xR = inR[i];
+                const F4 y = tick(F4(xL, xR, xL, xR), lowG, midG, highG, F4(gain_.next()), clip);
+                outL[i] = y.lane0();
+                outR[i] = y.lane1();
             }
         }
 
-        // safety clamp (évite NaN/inf de polluer)
-        yL = std::clamp(yL, -2.0f, 2.0f);
-        yR = std::clamp(yR, -2.0f, 2.0f);
-
-        outL = yL;
-        outR = yR;
+        // entrée seule : après 10 ms d'entrée nulle, les one-pole sont retombés
+        if (silence_.update(inPeak, n))
+            reset();
     }
 
 private:
-    static inline float dbToLin(float db)
+    // 0 = pas de clip, 1 = soft, 2 = hard
+    int clipKind() const { return clipOn_ ? (clipMode_ == 1 ? 2 : 1) : 0; }
+
+    // Un sample stéréo. Lanes du vecteur : {L, R, L, R}.
+    // z_ = {lowL, lowR, hpL, hpR} : les 4 one-pole avancent ensemble.
+    // Le résultat utile est dans les lanes 0/1.
+    inline F4 tick(F4 x, F4 lowG, F4 midG, F4 highG, F4 gain, int clip)
     {
-        return std::pow(10.0f, db / 20.0f);
+        z_ += a_ * (x - z_);
+        const F4 low = z_;
+        const F4 high = x - z_.swapHalves();
+        const F4 mid = x - low - high;
+
+        F4 y = low * lowG + mid * midG + high * highG;
+        y *= gain;
+
+        if (clip == 1)      y = softClip(y);
+        else if (clip == 2) y = clamp(y, F4(-1.0f), F4(1.0f));
+
+        // safety clamp (évite NaN/inf de polluer)
+        return clamp(y, F4(-2.0f), F4(2.0f));
     }
 
-    static inline float hardClip(float x)
+    static inline float dbToLin(float db)
     {
-        if (x > 1.0f) return 1.0f;
-        if (x < -1.0f) return -1.0f;
-        return x;
+        return std::pow(10.0f, db / 20.0f);
     }
 
     void updateFilters()
@@ -96,18 +143,17 @@ private:
         const float lowHz = 200.0f;
         const float highHz = 3000.0f;
 
-        lowLP_L.setCutoff(lowHz, sr_);
-        lowLP_R.setCutoff(lowHz, sr_);
-        highHP_L.setCutoff(highHz, sr_);
-        highHP_R.setCutoff(highHz, sr_);
+        OnePoleLP low, high;
+        low.setCutoff(lowHz, sr_);
+        high.setCutoff(highHz, sr_);
+        a_ = F4(low.a, low.a, high.a, high.a);
     }
 
     float sr_ = 48000.0f;
 
-    OnePoleLP lowLP_L{};
-    OnePoleLP lowLP_R{};
-    OnePoleHP highHP_L{};
-    OnePoleHP highHP_R{};
+    // coeffs / états {lowL, lowR, hpL, hpR}
+    F4 a_{ 0.0f };
+    F4 z_{ 0.0f };
 
     float lowDb_ = 0.0f;
     float midDb_ = 0.0f;
@@ -117,6 +163,9 @@ private:
     float midG_ = 1.0f;
     float highG_ = 1.0f;
 
+    SmoothedValue gain_{ 1.0f };
+    SilenceDetector silence_{};
+
     bool clipOn_ = true;
     int clipMode_ = 0; // 0=softClip, 1=hard
 };
@@ -1,6 +1,7 @@
 // Drumbox/core/include/drumbox_core/dsp/OnePole.h
 
 #pragma once
+#include "drumbox_core/dsp/Denormals.h"
 #include <cmath>
 
 namespace drumbox_core {
@@ -16,7 +17,7 @@ struct OnePoleLP {
     }
 
     float process(float in) {
-        z += a * (in - z);
+        z = flushDenormal(z + a * (in - z));
         return z;
     }
 
@@ -2,6 +2,7 @@
 
 #pragma once
 #include "drumbox_core/dsp/OnePole.h"
+#include "drumbox_core/dsp/Simd.h"
 
 #include <algorithm>
 #include <cmath>
@@ -22,10 +23,9 @@ struct Ott3Band
 
     void reset()
     {
-        lowLP_L.reset(); lowLP_R.reset();
-        highHP_L.reset(); highHP_R.reset();
-        envLow_L = envMid_L = envHigh_L = 0.0f;
-        envLow_R = envMid_R = envHigh_R = 0.0f;
+        z_ = F4(0.0f);
+        envLH_ = F4(0.0f);
+        envMid_ = F4(0.0f, 0.0f, kIdle, kIdle);
     }
 
     void setParams(float amount, float attackMs = 2.0f, float releaseMs = 60.0f)
@@ -35,10 +35,10 @@ struct Ott3Band
         releaseMs_ = std::clamp(releaseMs, 5.0f, 500.0f);
 
         // split points fixes (simple)
-        lowLP_L.setCutoff(180.0f, sr_);
-        lowLP_R.setCutoff(180.0f, sr_);
-        highHP_L.setCutoff(2600.0f, sr_);
-        highHP_R.setCutoff(2600.0f, sr_);
+        OnePoleLP low, high;
+        low.setCutoff(180.0f, sr_);
+        high.setCutoff(2600.0f, sr_);
+        a_ = F4(low.a, low.a, high.a, high.a);
 
         atkCoeff_ = msToCoeff(attackMs_, sr_);
         relCoeff_ = msToCoeff(releaseMs_, sr_);
@@ -53,40 +53,25 @@ struct Ott3Band
             return;
         }
 
-        // 3-band split
-        float lowL = lowLP_L.process(inL);
-        float highL = highHP_L.process(inL);
-        float midL = inL - lowL - highL;
-
-        float lowR = lowLP_R.process(inR);
-        float highR = highHP_R.process(inR);
-        float midR = inR - lowR - highR;
-
-        // env followers (per band, per channel)
-        envLow_L = follow(envLow_L, std::fabs(lowL));
-        envMid_L = follow(envMid_L, std::fabs(midL));
-        envHigh_L = follow(envHigh_L, std::fabs(highL));
-
-        envLow_R = follow(envLow_R, std::fabs(lowR));
-        envMid_R = follow(envMid_R, std::fabs(midR));
-        envHigh_R = follow(envHigh_R, std::fabs(highR));
-
-        // gains (OTT-ish): upward pour les faibles niveaux + downward pour les forts
-        const float gLowL = ottGain(envLow_L);
-        const float gMidL = ottGain(envMid_L);
-        const float gHighL = ottGain(envHigh_L);
-
-        const float gLowR = ottGain(envLow_R);
-        const float gMidR = ottGain(envMid_R);
-        const float gHighR = ottGain(envHigh_R);
+        const F4 y = tick(F4(inL, inR, inL, inR));
+        outL = y.lane0();
+        outR = y.lane1();
+    }
 
-        float yL = lowL * gLowL + midL * gMidL + highL * gHighL;
-        float yR = lowR * gLowR + midR * gMidR + highR * gHighR;
+    // Version bloc, en place.
+    void processBlock(float* ioL, float* ioR, int n)
+    {
+        if (amount_ <= 0.0001f)
+            return;
 
-        // léger trim pour éviter de gonfler trop
-        const float trim = 1.0f - 0.35f * amount_;
-        outL = yL * trim;
-        outR = yR * trim;
+        for (int i = 0; i < n; ++i)
+        {
+            const float xL = ioL[i];
+            const float xR = ioR[i];
+            const F4 y = tick(F4(xL, xR, xL, xR));
+            ioL[i] = y.lane0();
+            ioR[i] = y.lane1();
+        }
     }
 
 private:
@@ -98,41 +83,72 @@ private:
         return std::clamp(a, 0.0f, 0.999999f);
     }
 
-    inline float follow(float z, float x)
+    // Un sample stéréo, lanes {L, R, L, R} ; sortie utile dans les lanes 0/1.
+    // Les 3 bandes x 2 canaux tiennent dans 2 vecteurs :
+    // {lowL, lowR, highL, highR} et {midL, midR, -, -}.
+    inline F4 tick(F4 x)
+    {
+        // 3-band split
+        z_ += a_ * (x - z_);
+        const F4 hp = x - z_.swapHalves();                        // lanes 0/1 = high
+        const F4 lh = F4::lowHalves(z_, hp);
+        // lanes 2/3 de mid forcées à kIdle : leur enveloppe reste entre les deux seuils
+        const F4 mid = F4::lowHalves(x - z_ - hp, F4(kIdle));     // lanes 0/1 = mid
+
+        // env followers (par bande, par canal)
+        envLH_ = follow(envLH_, abs(lh));
+        envMid_ = follow(envMid_, abs(mid));
+
+        // gains (OTT-ish): upward pour les faibles niveaux + downward pour les forts
+        const F4 pLH = lh * ottGain(envLH_);
+        const F4 pMid = mid * ottGain(envMid_);
+
+        // (low + mid) + high
+        const F4 y = pLH + pMid + pLH.swapHalves();
+
+        // léger trim pour éviter de gonfler trop
+        return y * F4(1.0f - 0.35f * amount_);
+    }
+
+    inline F4 follow(F4 z, F4 x) const
     {
-        const float coeff = (x > z) ? atkCoeff_ : relCoeff_;
+        const F4 coeff = select(cmpGt(x, z), F4(atkCoeff_), F4(relCoeff_));
         // z = a*z + (1-a)*x
-        return z * coeff + x * (1.0f - coeff);
+        return z * coeff + x * (F4(1.0f) - coeff);
     }
 
-    inline float ottGain(float env) const
+    inline F4 ottGain(F4 env) const
     {
         // thresholds fixes (simple) :
         // - upward: pousse les signaux sous -24dB (~0.063)
         // - downward: compresse au-dessus de -9dB (~0.355)
-        const float eps = 1.0e-6f;
-        const float upT = 0.063f;
-        const float downT = 0.355f;
-
-        float gUp = 1.0f;
-        if (env < upT)
+        const F4 eps(1.0e-6f);
+        const F4 upT(0.063f);
+        const F4 downT(0.355f);
+        const F4 one(1.0f);
+        const F4 amount(amount_);
+
+        // branches calculées sur tout le vecteur puis masquées ;
+        // sautées (avec leurs divisions) si aucune lane n'est concernée
+        F4 gUp = one;
+        const F4 up = cmpLt(env, upT);
+        if (anyTrue(up))
         {
-            const float ratio = upT / (env + eps);
+            const F4 ratio = upT / (env + eps);
             // limite la remontée
-            gUp = 1.0f + amount_ * std::clamp(ratio - 1.0f, 0.0f, 6.0f);
+            gUp = select(up, one + amount * clamp(ratio - one, F4(0.0f), F4(6.0f)), one);
         }
 
-        float gDown = 1.0f;
-        if (env > downT)
+        F4 gDown = one;
+        const F4 down = cmpGt(env, downT);
+        if (anyTrue(down))
         {
-            const float over = (env - downT) / downT;
+            const F4 over = (env - downT) / downT;
             // réduction douce (jusqu'à ~-12dB)
-            gDown = 1.0f / (1.0f + amount_ * 2.5f * over);
-            gDown = std::clamp(gDown, 0.25f, 1.0f);
+            gDown = select(down, clamp(one / (one + F4(amount_ * 2.5f) * over), F4(0.25f), one), one);
         }
 
-        const float g = gUp * gDown;
-        return std::clamp(g, 0.25f, 6.0f);
+        return clamp(gUp * gDown, F4(0.25f), F4(6.0f));
     }
 
     float sr_ = 48000.0f;
@@ -143,13 +159,14 @@ private:
     float atkCoeff_ = 0.9f;
     float relCoeff_ = 0.99f;
 
-    OnePoleLP lowLP_L{};
-    OnePoleLP lowLP_R{};
-    OnePoleHP highHP_L{};
-    OnePoleHP highHP_R{};
+    // coeffs / états des splits {lowL, lowR, hpL, hpR}
+    F4 a_{ 0.0f };
+    F4 z_{ 0.0f };
 
-    float envLow_L = 0.0f, envMid_L = 0.0f, envHigh_L = 0.0f;
-    float envLow_R = 0.0f, envMid_R = 0.0f, envHigh_R = 0.0f;
+    // enveloppes {lowL, lowR, highL, highR} et {midL, midR, -, -}
+    static constexpr float kIdle = 0.1f; // entre upT et downT (aucun gain)
+    F4 envLH_{ 0.0f };
+    F4 envMid_{ 0.0f, 0.0f, kIdle, kIdle };
 };
 
 } // namespace drumbox_core
@@ -0,0 +1,201 @@
+// Drumbox/core/include/drumbox_core/dsp/Oversampler.h
+
+#pragma once
+
+namespace drumbox_core {
+
+// Half-band IIR polyphase : deux chaînes d'allpass du 1er ordre (au taux bas),
+// design elliptique de L. de Soras (HIIR). Coeffs pairs -> chemin 0, impairs -> chemin 1.
+// Un même type sert à monter (1 -> 2 samples) ou à descendre (2 -> 1), avec un état par usage.
+template <int NC>
+struct HalfBand2x
+{
+    static_assert(NC >= 1, "HalfBand2x: NC >= 1");
+
+    const float* coef = nullptr;
+    float x[NC]{};
+    float y[NC]{};
+
+    void reset()
+    {
+        for (int i = 0; i < NC; ++i)
+        {
+            x[i] = 0.0f;
+            y[i] = 0.0f;
+        }
+    }
+
+    inline void up(float in, float& out0, float& out1)
+    {
+        float a = in;
+        float b = in;
+        paths(a, b);
+        out0 = a;
+        out1 = b;
+    }
+
+    inline float down(float in0, float in1)
+    {
+        float a = in1;
+        float b = in0;
+        paths(a, b);
+        return 0.5f * (a + b);
+    }
+
+    // Retard de groupe au DC d'un up + down, en samples du taux bas
+    static float latency(const float* c)
+    {
+        float s = 0.0f;
+        for (int i = 0; i < NC; ++i)
+            s += (1.0f - c[i]) / (1.0f + c[i]);
+        return s;
+    }
+
+private:
+    inline void paths(float& a, float& b)
+    {
+        for (int i = 0; i < NC; i += 2)
+        {
+            a = allpass(i, a);
+            if (i + 1 < NC)
+                b = allpass(i + 1, b);
+        }
+    }
+
+    inline float allpass(int i, float v)
+    {
+        const float t = (v - y[i]) * coef[i] + x[i];
+        x[i] = v;
+        y[i] = t;
+        return t;
+    }
+};
+
+// Oversampling 1x/2x/4x/8x par cascade d'étages half-band.
+// - étage 1 (sr <-> 2 sr) : 8 coeffs, transition 0.04, ~ -99 dB
+// - étages 2 et 3 : la bande utile est déjà limitée, 4 puis 3 coeffs suffisent
+// process() pour une non-linéarité par sample (état récursif dans fn),
+// upsample()/downsample() pour traiter des blocs entiers, étage par étage.
+struct Oversampler
+{
+    static constexpr int kMaxFactor = 8;
+
+    // 1, 2, 4 ou 8 (arrondi en dessous). Changement de facteur : états remis à zéro.
+    void setFactor(int factor)
+    {
+        const int stages = (factor >= 8) ? 3 : (factor >= 4) ? 2 : (factor >= 2) ? 1 : 0;
+        if (stages == stages_)
+            return;
+        stages_ = stages;
+        reset();
+    }
+
+    int factor() const { return 1 << stages_; }
+
+    // Retard ajouté par up + down, en samples au taux de base
+    float latency() const
+    {
+        float l = 0.0f;
+        if (stages_ >= 1) l += HalfBand2x<8>::latency(kCoef1);
+        if (stages_ >= 2) l += HalfBand2x<4>::latency(kCoef2) * 0.5f;
+        if (stages_ >= 3) l += HalfBand2x<3>::latency(kCoef3) * 0.25f;
+        return l;
+    }
+
+    void reset()
+    {
+        up1_.coef = down1_.coef = kCoef1;
+        up2_.coef = down2_.coef = kCoef2;
+        up3_.coef = down3_.coef = kCoef3;
+        up1_.reset(); down1_.reset();
+        up2_.reset(); down2_.reset();
+        up3_.reset(); down3_.reset();
+    }
+
+    // fn(x) appelé factor() fois au taux suréchantillonné
+    template <typename Fn>
+    inline float process(float in, Fn&& fn)
+    {
+        if (stages_ == 0)
+            return fn(in);
+
+        float a[kMaxFactor];
+        float b[kMaxFactor];
+        a[0] = in;
+        int n = 1;
+
+        expand(up1_, a, n, b); n *= 2;
+        float* cur = b;
+        if (stages_ >= 2) { expand(up2_, b, n, a); n *= 2; cur = a; }
+        if (stages_ >= 3) { expand(up3_, a, n, b); n *= 2; cur = b; }
+
+        for (int i = 0; i < n; ++i)
+            cur[i] = fn(cur[i]);
+
+        if (stages_ >= 3) { reduce(down3_, cur, n); n /= 2; }
+        if (stages_ >= 2) { reduce(down2_, cur, n); n /= 2; }
+        reduce(down1_, cur, n);
+        return cur[0];
+    }
+
+    // in[0..n) -> out[0..n * factor()) ; in peut être la fin de out
+    void upsample(const float* in, int n, float* out)
+    {
+        const int total = n * factor();
+        if (stages_ == 0)
+        {
+            for (int i = 0; i < n; ++i)
+                out[i] = in[i];
+            return;
+        }
+
+        // chaque étage lit la fin du buffer et écrit devant : jamais d'écrasement
+        // d'un sample pas encore lu, et l'ordre temporel des états est respecté
+        const float* src = in;
+        int m = n;
+        expand(up1_, src, m, out + total - 2 * m); m *= 2;
+        if (stages_ >= 2) { expand(up2_, out + total - m, m, out + total - 2 * m); m *= 2; }
+        if (stages_ >= 3) { expand(up3_, out + total - m, m, out + total - 2 * m); m *= 2; }
+    }
+
+    // io[0..n * factor()) -> io[0..n), en place
+    void downsample(float* io, int n)
+    {
+        int m = n * factor();
+        if (stages_ >= 3) { reduce(down3_, io, m); m /= 2; }
+        if (stages_ >= 2) { reduce(down2_, io, m); m /= 2; }
+        if (stages_ >= 1) { reduce(down1_, io, m); }
+    }
+
+private:
+    // Coeffs HIIR (nb coeffs, largeur de transition) : (8, 0.04) (4, 0.25) (3, 0.30)
+    static constexpr float kCoef1[8] = {
+        0.040633461f, 0.150505129f, 0.300757056f, 0.460774505f,
+        0.609524315f, 0.738503841f, 0.849223810f, 0.949742784f
+    };
+    static constexpr float kCoef2[4] = { 0.042454710f, 0.170739850f, 0.393319893f, 0.745713589f };
+    static constexpr float kCoef3[3] = { 0.062735753f, 0.263732334f, 0.665815091f };
+
+    template <typename Stage>
+    static inline void expand(Stage& st, const float* in, int n, float* out)
+    {
+        for (int i = 0; i < n; ++i)
+            st.up(in[i], out[2 * i], out[2 * i + 1]);
+    }
+
+    // io[0..n) -> io[0..n/2)
+    template <typename Stage>
+    static inline void reduce(Stage& st, float* io, int n)
+    {
+        for (int i = 0; i < n / 2; ++i)
+            io[i] = st.down(io[2 * i], io[2 * i + 1]);
+    }
+
+    int stages_ = 0;
+
+    HalfBand2x<8> up1_{ kCoef1 }, down1_{ kCoef1 };
+    HalfBand2x<4> up2_{ kCoef2 }, down2_{ kCoef2 };
+    HalfBand2x<3> up3_{ kCoef3 }, down3_{ kCoef3 };
+};
+
+} // namespace drumbox_core
@@ -0,0 +1,72 @@
+// Drumbox/core/include/drumbox_core/dsp/PolyBlep.h
+
+#pragma once
+
+namespace drumbox_core {
+
+// Formes d'onde à bande limitée par correction polynomiale autour des discontinuités :
+// PolyBLEP pour les sauts (carré), PolyBLAMP pour les cassures de pente (triangle).
+// Rien à précalculer, coût constant hors des 2 samples autour d'un front.
+//   t  : phase normalisée [0..1)
+//   dt : incrément de phase par sample (fréquence / sr), 0 < dt < 0.5
+namespace polyblep {
+
+// résidu d'un saut de hauteur 2 situé en t = 0
+inline float blep(float t, float dt)
+{
+    if (t < dt)
+    {
+        t /= dt;
+        return t + t - t * t - 1.0f;
+    }
+    if (t > 1.0f - dt)
+    {
+        t = (t - 1.0f) / dt;
+        return t * t + t + t + 1.0f;
+    }
+    return 0.0f;
+}
+
+// résidu intégré (cassure de pente) situé en t = 0
+inline float blamp(float t, float dt)
+{
+    if (t < dt)
+    {
+        t = t / dt - 1.0f;
+        return -(1.0f / 3.0f) * t * t * t;
+    }
+    if (t > 1.0f - dt)
+    {
+        t = (t - 1.0f) / dt + 1.0f;
+        return (1.0f / 3.0f) * t * t * t;
+    }
+    return 0.0f;
+}
+
+inline float halfTurn(float t) { return (t >= 0.5f) ? (t - 0.5f) : (t + 0.5f); }
+
+inline float clampDt(float dt) { return (dt < 1.0e-6f) ? 1.0e-6f : ((dt > 0.499f) ? 0.499f : dt); }
+
+// +1 sur [0..0.5), -1 sur [0.5..1)
+inline float square(float t, float dt)
+{
+    dt = clampDt(dt);
+    float y = (t < 0.5f) ? 1.0f : -1.0f;
+    y += blep(t, dt);
+    y -= blep(halfTurn(t), dt);
+    return y;
+}
+
+// +1 en t = 0, -1 en t = 0.5 (pente 4 par tour)
+inline float triangle(float t, float dt)
+{
+    dt = clampDt(dt);
+    const float d = t - 0.5f;
+    float y = 4.0f * ((d < 0.0f) ? -d : d) - 1.0f;
+    y += 4.0f * dt * (blamp(halfTurn(t), dt) - blamp(t, dt));
+    return y;
+}
+
+} // namespace polyblep
+
+} // namespace drumbox_core
@@ -1,29 +1,69 @@
 // Drumbox/core/include/drumbox_core/dsp/ReverbSchroeder.h
 
 #pragma once
+#include "drumbox_core/dsp/DelayArena.h"
+#include "drumbox_core/dsp/Denormals.h"
+#include "drumbox_core/dsp/SilenceDetector.h"
+
 #include <cstdint>
 #include <algorithm>
+#include <cmath>
 
 namespace drumbox_core {
 
-// Reverb courte type Schroeder (comb + allpass), buffers fixes, sans allocation.
+// Reverb courte type Schroeder (comb + allpass), sans allocation dans le rendu.
 // Conçue pour une "kick tail" (petites tailles, CPU léger).
+// Les buffers viennent d'une DelayArena, longueurs calculées au prepare() selon le sr.
 struct ReverbSchroeder
 {
-    void prepare(float sampleRate)
+    // Mémoire nécessaire (en floats) pour ce sample rate
+    static size_t requiredFloats(float sampleRate)
+    {
+        const float sr = clampSr(sampleRate);
+        size_t n = 0;
+        for (int len : kCombL) n += (size_t)scaleDelay(len, sr);
+        for (int len : kCombR) n += (size_t)scaleDelay(len, sr);
+        for (int len : kApL)   n += (size_t)scaleDelay(len, sr);
+        for (int len : kApR)   n += (size_t)scaleDelay(len, sr);
+        return n;
+    }
+
+    // Non temps réel. Arena trop petite => reverb inactive (sortie nulle).
+    void prepare(float sampleRate, DelayArena& arena)
     {
-        sr_ = (sampleRate > 8000.0f) ? sampleRate : 8000.0f;
+        sr_ = clampSr(sampleRate);
+
+        ready_ = true;
+        for (int k = 0; k < 4; ++k)
+        {
+            ready_ &= combL_[k].attach(arena, scaleDelay(kCombL[k], sr_));
+            ready_ &= combR_[k].attach(arena, scaleDelay(kCombR[k], sr_));
+        }
+        for (int k = 0; k < 2; ++k)
+        {
+            ready_ &= apL_[k].attach(arena, scaleDelay(kApL[k], sr_));
+            ready_ &= apR_[k].attach(arena, scaleDelay(kApR[k], sr_));
+        }
+
+        // silencieux après 2 tours de la boucle la plus longue (comb + allpass)
+        silence_.prepare(2 * (scaleDelay(kCombR[3], sr_) + scaleDelay(kApR[1], sr_)));
         reset();
     }
 
     void reset()
     {
-        combL0_.reset(); combL1_.reset(); combL2_.reset(); combL3_.reset();
-        combR0_.reset(); combR1_.reset(); combR2_.reset(); combR3_.reset();
-        apL0_.reset(); apL1_.reset();
-        apR0_.reset(); apR1_.reset();
+        for (auto& c : combL_) c.reset();
+        for (auto& c : combR_) c.reset();
+        for (auto& a : apL_) a.reset();
+        for (auto& a : apR_) a.reset();
+        silence_.reset();
     }
 
+    bool isReady() const { return ready_; }
+
+    // Queue éteinte (suivi fait par processBlock) : sortie nulle tant que l'entrée l'est.
+    bool isSilent() const { return silence_.isSilent(); }
+
     // amount: 0..1 (wet)
     // size:   0..1 (feedback / "room")
     // tone:   0..1 (0=dark (damp fort), 1=bright (damp faible))
@@ -42,26 +82,23 @@ struct ReverbSchroeder
     // Entrée mono, sortie stéréo.
     inline void processMono(float x, float& outL, float& outR)
     {
+        if (!ready_)
+        {
+            outL = outR = 0.0f;
+            return;
+        }
+
         // petite pré-atténuation pour éviter de saturer la boucle
         const float in = x * 0.25f;
 
         float l = 0.0f;
         float r = 0.0f;
 
-        l += combL0_.process(in, feedback_, damp_);
-        l += combL1_.process(in, feedback_, damp_);
-        l += combL2_.process(in, feedback_, damp_);
-        l += combL3_.process(in, feedback_, damp_);
-
-        r += combR0_.process(in, feedback_, damp_);
-        r += combR1_.process(in, feedback_, damp_);
-        r += combR2_.process(in, feedback_, damp_);
-        r += combR3_.process(in, feedback_, damp_);
+        for (auto& c : combL_) l += c.process(in, feedback_, damp_);
+        for (auto& c : combR_) r += c.process(in, feedback_, damp_);
 
-        l = apL0_.process(l);
-        l = apL1_.process(l);
-        r = apR0_.process(r);
-        r = apR1_.process(r);
+        for (auto& a : apL_) l = a.process(l);
+        for (auto& a : apR_) r = a.process(r);
 
         // Normalisation légère (dépend du nb de combs)
         l *= 0.25f;
@@ -72,19 +109,64 @@ struct ReverbSchroeder
         outR = r * wet;
     }
 
+    // Version bloc: chaque comb/allpass traite le bloc entier (état en registres).
+    // x[0..n) mono, outL/outR écrasés.
+    void processBlock(const float* x, float* outL, float* outR, int n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            outL[i] = 0.0f;
+            outR[i] = 0.0f;
+        }
+
+        if (!ready_)
+            return;
+
+        for (auto& c : combL_) c.processBlock(x, outL, n, feedback_, damp_);
+        for (auto& c : combR_) c.processBlock(x, outR, n, feedback_, damp_);
+
+        for (auto& a : apL_) a.processBlock(outL, n);
+        for (auto& a : apR_) a.processBlock(outR, n);
+
+        // niveau de la boucle avant le wet (wet = 0 n'empêche pas la queue de tourner)
+        float peak = SilenceDetector::peak(x, n);
+        const float wet = wet_;
+        for (int i = 0; i < n; ++i)
+        {
+            const float l = outL[i] * 0.25f;
+            const float r = outR[i] * 0.25f;
+            peak = std::max(peak, std::max(std::abs(l), std::abs(r)));
+            outL[i] = l * wet;
+            outR[i] = r * wet;
+        }
+
+        // queue retombée sous le seuil : on vide les buffers (plus de dénormaux qui traînent)
+        if (silence_.update(peak, n))
+            reset();
+    }
+
 private:
     static inline float clamp01(float v) { return (v < 0.0f) ? 0.0f : ((v > 1.0f) ? 1.0f : v); }
+    static inline float clampSr(float sr) { return (sr > 8000.0f) ? sr : 8000.0f; }
 
-    template <int N>
     struct Comb
     {
-        float buf[N]{};
+        float* buf = nullptr;
+        int size = 0;
         int idx = 0;
         float filterStore = 0.0f;
 
+        bool attach(DelayArena& arena, int n)
+        {
+            buf = arena.take(n);
+            size = buf ? n : 0;
+            reset();
+            return buf != nullptr;
+        }
+
         void reset()
         {
-            for (int i = 0; i < N; ++i) buf[i] = 0.0f;
+            for (int i = 0; i < size; ++i) buf[i] = 0.0f;
             idx = 0;
             filterStore = 0.0f;
         }
@@ -94,24 +176,49 @@ private:
             const float output = buf[idx];
 
             // lowpass dans la boucle (freeverb style)
-            filterStore = output * (1.0f - damp) + filterStore * damp;
+            filterStore = flushDenormal(output * (1.0f - damp) + filterStore * damp);
             buf[idx] = input + filterStore * feedback;
 
-            if (++idx >= N) idx = 0;
+            if (++idx >= size) idx = 0;
             return output;
         }
+
+        // acc[i] += comb(x[i] * 0.25), état gardé en local sur le bloc
+        inline void processBlock(const float* x, float* acc, int n, float feedback, float damp)
+        {
+            int i0 = idx;
+            float fs = filterStore;
+            for (int i = 0; i < n; ++i)
+            {
+                const float output = buf[i0];
+                fs = output * (1.0f - damp) + fs * damp;
+                buf[i0] = flushDenormal(x[i] * 0.25f + fs * feedback);
+                if (++i0 >= size) i0 = 0;
+                acc[i] += output;
+            }
+            idx = i0;
+            filterStore = flushDenormal(fs); // hors de la récurrence : une fois par bloc
+        }
     };
 
-    template <int N>
     struct Allpass
     {
-        float buf[N]{};
+        float* buf = nullptr;
+        int size = 0;
         int idx = 0;
         float feedback = 0.5f;
 
+        bool attach(DelayArena& arena, int n)
+        {
+            buf = arena.take(n);
+            size = buf ? n : 0;
+            reset();
+            return buf != nullptr;
+        }
+
         void reset()
         {
-            for (int i = 0; i < N; ++i) buf[i] = 0.0f;
+            for (int i = 0; i < size; ++i) buf[i] = 0.0f;
             idx = 0;
         }
 
@@ -119,29 +226,42 @@ private:
         {
             const float bufout = buf[idx];
             const float output = -input + bufout;
-            buf[idx] = input + bufout * feedback;
+            buf[idx] = flushDenormal(input + bufout * feedback);
 
-            if (++idx >= N) idx = 0;
+            if (++idx >= size) idx = 0;
             return output;
         }
+
+        inline void processBlock(float* io, int n)
+        {
+            int i0 = idx;
+            const float fb = feedback;
+            for (int i = 0; i < n; ++i)
+            {
+                const float input = io[i];
+                const float bufout = buf[i0];
+                buf[i0] = flushDenormal(input + bufout * fb);
+                if (++i0 >= size) i0 = 0;
+                io[i] = -input + bufout;
+            }
+            idx = i0;
+        }
     };
 
-    // Delays inspirés Freeverb (mais réduits) — valeurs fixes (pas d'allocation).
+    // Delays inspirés Freeverb (mais réduits), en samples à 48 kHz.
     // L/R légèrement différents pour élargir la stéréo.
-    Comb<1116> combL0_{};
-    Comb<1188> combL1_{};
-    Comb<1277> combL2_{};
-    Comb<1356> combL3_{};
-
-    Comb<1139> combR0_{};
-    Comb<1211> combR1_{};
-    Comb<1300> combR2_{};
-    Comb<1379> combR3_{};
-
-    Allpass<225> apL0_{};
-    Allpass<341> apL1_{};
-    Allpass<248> apR0_{};
-    Allpass<364> apR1_{};
+    static constexpr int kCombL[4] = { 1116, 1188, 1277, 1356 };
+    static constexpr int kCombR[4] = { 1139, 1211, 1300, 1379 };
+    static constexpr int kApL[2] = { 225, 341 };
+    static constexpr int kApR[2] = { 248, 364 };
+
+    Comb combL_[4]{};
+    Comb combR_[4]{};
+    Allpass apL_[2]{};
+    Allpass apR_[2]{};
+    bool ready_ = false;
+
+    SilenceDetector silence_{};
 
     float sr_ = 48000.0f;
     float wet_ = 0.0f;
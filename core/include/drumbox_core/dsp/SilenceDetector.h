@@ -0,0 +1,66 @@
+// Drumbox/core/include/drumbox_core/dsp/SilenceDetector.h
+
+#pragma once
+#include <cmath>
+
+namespace drumbox_core {
+
+// Suivi de silence d'un étage avec queue (reverb, FX, master).
+// L'étage est "silencieux" quand son entrée et son état sont restés sous le seuil
+// pendant holdSamples : la sortie est alors nulle tant que l'entrée l'est,
+// l'Engine peut sauter l'étage et écrire des zéros.
+struct SilenceDetector
+{
+    static constexpr float kThreshold = 1.0e-5f; // ~ -100 dB
+
+    void prepare(int holdSamples)
+    {
+        hold_ = (holdSamples > 1) ? holdSamples : 1;
+        quiet_ = hold_;
+    }
+
+    // état vidé = silencieux
+    void reset() { quiet_ = hold_; }
+
+    bool isSilent() const { return quiet_ >= hold_; }
+
+    // peak: max |x| vu par l'étage sur le bloc (entrée et état/sortie).
+    // Renvoie true au passage dans l'état silencieux (l'étage vide alors ses buffers).
+    bool update(float peak, int n)
+    {
+        if (peak > kThreshold)
+        {
+            quiet_ = 0;
+            return false;
+        }
+        if (quiet_ >= hold_)
+            return false;
+
+        quiet_ += n;
+        return quiet_ >= hold_;
+    }
+
+    static inline float peak(const float* x, int n)
+    {
+        float p = 0.0f;
+        for (int i = 0; i < n; ++i)
+        {
+            const float a = std::fabs(x[i]);
+            p = (a > p) ? a : p;
+        }
+        return p;
+    }
+
+    static inline float peak(const float* l, const float* r, int n)
+    {
+        const float pl = peak(l, n);
+        const float pr = peak(r, n);
+        return (pl > pr) ? pl : pr;
+    }
+
+private:
+    int hold_ = 1;
+    int quiet_ = 1;
+};
+
+} // namespace drumbox_core
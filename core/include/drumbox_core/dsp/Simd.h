@@ -0,0 +1,178 @@
+// Drumbox/core/include/drumbox_core/dsp/Simd.h
+
+#pragma once
+
+// Vecteur 4 x float minimal : SSE2 (x86/x64), NEON (ARM), sinon fallback scalaire.
+// Définir DRUMBOX_SIMD_SCALAR pour forcer le fallback (comparaison A/B).
+// Uniquement des opérations IEEE exactes (+ - * / min max) : mêmes résultats que le code scalaire.
+
+#if !defined(DRUMBOX_SIMD_SCALAR)
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define DRUMBOX_SIMD_SSE 1
+    #include <emmintrin.h>
+  #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define DRUMBOX_SIMD_NEON 1
+    #include <arm_neon.h>
+  #endif
+#endif
+
+namespace drumbox_core {
+
+struct F4
+{
+#if defined(DRUMBOX_SIMD_SSE)
+    __m128 v;
+
+    F4() = default;
+    explicit F4(__m128 x) : v(x) {}
+    explicit F4(float s) : v(_mm_set1_ps(s)) {}
+    F4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+    static F4 load(const float* p) { return F4(_mm_loadu_ps(p)); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    float lane0() const { return _mm_cvtss_f32(v); }
+    float lane1() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))); }
+
+    // {a, b, c, d} -> {c, d, a, b}
+    F4 swapHalves() const { return F4(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2))); }
+    // {a0, a1, b0, b1}
+    static F4 lowHalves(F4 a, F4 b) { return F4(_mm_shuffle_ps(a.v, b.v, _MM_SHUFFLE(1, 0, 1, 0))); }
+    // {a0, b0, a1, b1} / {a2, b2, a3, b3}
+    static F4 zipLow(F4 a, F4 b) { return F4(_mm_unpacklo_ps(a.v, b.v)); }
+    static F4 zipHigh(F4 a, F4 b) { return F4(_mm_unpackhi_ps(a.v, b.v)); }
+
+    friend F4 operator+(F4 a, F4 b) { return F4(_mm_add_ps(a.v, b.v)); }
+    friend F4 operator-(F4 a, F4 b) { return F4(_mm_sub_ps(a.v, b.v)); }
+    friend F4 operator*(F4 a, F4 b) { return F4(_mm_mul_ps(a.v, b.v)); }
+    friend F4 operator/(F4 a, F4 b) { return F4(_mm_div_ps(a.v, b.v)); }
+
+    // min/max dans l'ordre de std::min/std::max (b si égalité)
+    friend F4 min(F4 a, F4 b) { return F4(_mm_min_ps(b.v, a.v)); }
+    friend F4 max(F4 a, F4 b) { return F4(_mm_max_ps(b.v, a.v)); }
+    friend F4 abs(F4 a) { return F4(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)); }
+
+    // masques : lanes à 0xFFFFFFFF si vrai
+    friend F4 cmpGt(F4 a, F4 b) { return F4(_mm_cmpgt_ps(a.v, b.v)); }
+    friend F4 cmpLt(F4 a, F4 b) { return F4(_mm_cmplt_ps(a.v, b.v)); }
+    friend F4 select(F4 mask, F4 t, F4 f)
+    {
+        return F4(_mm_or_ps(_mm_and_ps(mask.v, t.v), _mm_andnot_ps(mask.v, f.v)));
+    }
+    friend bool anyTrue(F4 mask) { return _mm_movemask_ps(mask.v) != 0; }
+
+#elif defined(DRUMBOX_SIMD_NEON)
+    float32x4_t v;
+
+    F4() = default;
+    explicit F4(float32x4_t x) : v(x) {}
+    explicit F4(float s) : v(vdupq_n_f32(s)) {}
+    F4(float a, float b, float c, float d)
+    {
+        const float t[4] = { a, b, c, d };
+        v = vld1q_f32(t);
+    }
+
+    static F4 load(const float* p) { return F4(vld1q_f32(p)); }
+    void store(float* p) const { vst1q_f32(p, v); }
+    float lane0() const { return vgetq_lane_f32(v, 0); }
+    float lane1() const { return vgetq_lane_f32(v, 1); }
+
+    F4 swapHalves() const { return F4(vextq_f32(v, v, 2)); }
+    static F4 lowHalves(F4 a, F4 b) { return F4(vcombine_f32(vget_low_f32(a.v), vget_low_f32(b.v))); }
+    static F4 zipLow(F4 a, F4 b) { return F4(vzipq_f32(a.v, b.v).val[0]); }
+    static F4 zipHigh(F4 a, F4 b) { return F4(vzipq_f32(a.v, b.v).val[1]); }
+
+    friend F4 operator+(F4 a, F4 b) { return F4(vaddq_f32(a.v, b.v)); }
+    friend F4 operator-(F4 a, F4 b) { return F4(vsubq_f32(a.v, b.v)); }
+    friend F4 operator*(F4 a, F4 b) { return F4(vmulq_f32(a.v, b.v)); }
+  #if defined(__aarch64__) || defined(_M_ARM64)
+    friend F4 operator/(F4 a, F4 b) { return F4(vdivq_f32(a.v, b.v)); }
+  #else
+    friend F4 operator/(F4 a, F4 b)
+    {
+        float x[4], y[4];
+        vst1q_f32(x, a.v);
+        vst1q_f32(y, b.v);
+        return F4(x[0] / y[0], x[1] / y[1], x[2] / y[2], x[3] / y[3]);
+    }
+  #endif
+
+    friend F4 min(F4 a, F4 b) { return F4(vminq_f32(a.v, b.v)); }
+    friend F4 max(F4 a, F4 b) { return F4(vmaxq_f32(a.v, b.v)); }
+    friend F4 abs(F4 a) { return F4(vabsq_f32(a.v)); }
+
+    friend F4 cmpGt(F4 a, F4 b) { return F4(vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v))); }
+    friend F4 cmpLt(F4 a, F4 b) { return F4(vreinterpretq_f32_u32(vcltq_f32(a.v, b.v))); }
+    friend F4 select(F4 mask, F4 t, F4 f)
+    {
+        return F4(vbslq_f32(vreinterpretq_u32_f32(mask.v), t.v, f.v));
+    }
+    friend bool anyTrue(F4 mask)
+    {
+        const uint32x4_t m = vreinterpretq_u32_f32(mask.v);
+        const uint32x2_t o = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+        return (vget_lane_u32(o, 0) | vget_lane_u32(o, 1)) != 0;
+    }
+
+#else
+    // Fallback portable : mêmes opérations, lane par lane.
+    float v[4];
+
+    F4() = default;
+    explicit F4(float s) : v{ s, s, s, s } {}
+    F4(float a, float b, float c, float d) : v{ a, b, c, d } {}
+
+    static F4 load(const float* p) { return F4(p[0], p[1], p[2], p[3]); }
+    void store(float* p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+    float lane0() const { return v[0]; }
+    float lane1() const { return v[1]; }
+
+    F4 swapHalves() const { return F4(v[2], v[3], v[0], v[1]); }
+    static F4 lowHalves(F4 a, F4 b) { return F4(a.v[0], a.v[1], b.v[0], b.v[1]); }
+    static F4 zipLow(F4 a, F4 b) { return F4(a.v[0], b.v[0], a.v[1], b.v[1]); }
+    static F4 zipHigh(F4 a, F4 b) { return F4(a.v[2], b.v[2], a.v[3], b.v[3]); }
+
+    template <typename Op>
+    static F4 map(F4 a, F4 b, Op op)
+    {
+        return F4(op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]));
+    }
+
+    friend F4 operator+(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x + y; }); }
+    friend F4 operator-(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x - y; }); }
+    friend F4 operator*(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x * y; }); }
+    friend F4 operator/(F4 a, F4 b) { return map(a, b, [](float x, float y) { return x / y; }); }
+
+    friend F4 min(F4 a, F4 b) { return map(a, b, [](float x, float y) { return (y < x) ? y : x; }); }
+    friend F4 max(F4 a, F4 b) { return map(a, b, [](float x, float y) { return (x < y) ? y : x; }); }
+    friend F4 abs(F4 a) { return map(a, a, [](float x, float) { return (x < 0.0f) ? -x : x; }); }
+
+    // masque booléen stocké en 0/1 (jamais utilisé comme float)
+    friend F4 cmpGt(F4 a, F4 b) { return map(a, b, [](float x, float y) { return (x > y) ? 1.0f : 0.0f; }); }
+    friend F4 cmpLt(F4 a, F4 b) { return map(a, b, [](float x, float y) { return (x < y) ? 1.0f : 0.0f; }); }
+    friend F4 select(F4 mask, F4 t, F4 f)
+    {
+        return F4(mask.v[0] != 0.0f ? t.v[0] : f.v[0], mask.v[1] != 0.0f ? t.v[1] : f.v[1],
+                  mask.v[2] != 0.0f ? t.v[2] : f.v[2], mask.v[3] != 0.0f ? t.v[3] : f.v[3]);
+    }
+    friend bool anyTrue(F4 mask)
+    {
+        return mask.v[0] != 0.0f || mask.v[1] != 0.0f || mask.v[2] != 0.0f || mask.v[3] != 0.0f;
+    }
+#endif
+
+    F4& operator+=(F4 b) { return *this = *this + b; }
+    F4& operator-=(F4 b) { return *this = *this - b; }
+    F4& operator*=(F4 b) { return *this = *this * b; }
+};
+
+inline F4 clamp(F4 x, F4 lo, F4 hi) { return min(max(x, lo), hi); }
+
+// Même formule que softClip() (Saturation.h), même ordre d'opérations.
+inline F4 softClip(F4 x)
+{
+    const F4 x2 = x * x;
+    return x * (F4(27.0f) + x2) / (F4(27.0f) + F4(9.0f) * x2);
+}
+
+} // namespace drumbox_core
@@ -0,0 +1,101 @@
+// Drumbox/core/include/drumbox_core/dsp/Smoother.h
+
+#pragma once
+
+#include <cmath>
+
+namespace drumbox_core {
+
+// Lissage d'un paramètre (anti zipper) : rampe linéaire ou one-pole.
+// Au repos (cible atteinte), next() ne fait qu'un test : les DSP testent
+// isSmoothing() une fois par bloc et gardent leur chemin constant.
+struct SmoothedValue
+{
+    enum class Mode
+    {
+        Linear,  // rampe de durée fixe
+        OnePole  // approche exponentielle, arrêt à ~1% de la cible
+    };
+
+    SmoothedValue() = default;
+    explicit SmoothedValue(float initial) : current_(initial), target_(initial) {}
+
+    // Garde la valeur courante ; le premier setTarget qui suit saute directement
+    // à la cible (pas de rampe après un prepare / changement de sample rate).
+    void prepare(float sampleRate, float timeMs, Mode mode = Mode::Linear)
+    {
+        sr_ = (sampleRate > 1.0f) ? sampleRate : 1.0f;
+        mode_ = mode;
+        setTimeMs(timeMs);
+        current_ = target_;
+        remaining_ = 0;
+        primed_ = false;
+    }
+
+    void setTimeMs(float timeMs)
+    {
+        timeMs_ = (timeMs > 0.0f) ? timeMs : 0.0f;
+        steps_ = (int)(timeMs_ * 0.001f * sr_);
+
+        // one-pole: ~4.6 constantes de temps pour arriver à 1% de la cible
+        const float tau = (timeMs_ * 0.001f) / 4.6f;
+        coeff_ = (tau > 0.0f) ? (1.0f - std::exp(-1.0f / (tau * sr_))) : 1.0f;
+    }
+
+    void setTarget(float v)
+    {
+        if (!primed_ || steps_ <= 0)
+        {
+            snap(v);
+            return;
+        }
+        if (v == target_)
+            return;
+
+        target_ = v;
+        remaining_ = steps_;
+        inc_ = (target_ - current_) / (float)steps_;
+    }
+
+    // saut immédiat (nouvelle note, reset)
+    void snap(float v)
+    {
+        current_ = v;
+        target_ = v;
+        remaining_ = 0;
+        primed_ = true;
+    }
+
+    bool isSmoothing() const { return remaining_ > 0; }
+    float current() const { return current_; }
+    float target() const { return target_; }
+
+    inline float next()
+    {
+        if (remaining_ <= 0)
+            return current_;
+
+        if (--remaining_ == 0)
+            current_ = target_;
+        else if (mode_ == Mode::Linear)
+            current_ += inc_;
+        else
+            current_ += coeff_ * (target_ - current_);
+        return current_;
+    }
+
+private:
+    float sr_ = 48000.0f;
+    float timeMs_ = 20.0f;
+    Mode mode_ = Mode::Linear;
+
+    float current_ = 0.0f;
+    float target_ = 0.0f;
+    float inc_ = 0.0f;
+    float coeff_ = 1.0f;
+    int steps_ = 0;
+    int remaining_ = 0;
+    bool primed_ = false;
+};
+
+} // namespace drumbox_core
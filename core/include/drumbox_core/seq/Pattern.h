@@ -8,25 +8,29 @@ struct Step {
     float vel = 1.0f; // 0..1
 };
 
+// Pattern en valeur (kLanes lanes, jusqu'à kMaxSteps steps) : format d'échange
+// des outils (scènes). L'Engine stocke les siens dans une PatternBank.
 struct Pattern {
-    Step steps[kLanes][kSteps]{};
+    int length = kSteps;
+    Step steps[kLanes][kMaxSteps]{};
 
     void clear() {
+        length = kSteps;
         for (int l = 0; l < kLanes; ++l)
-            for (int s = 0; s < kSteps; ++s)
+            for (int s = 0; s < kMaxSteps; ++s)
                 steps[l][s] = Step{};
     }
 
     void setStep(int lane, int step, bool on, float vel) {
         if (lane < 0 || lane >= kLanes) return;
-        if (step < 0 || step >= kSteps) return;
+        if (step < 0 || step >= kMaxSteps) return;
         steps[lane][step].on = on;
         steps[lane][step].vel = vel;
     }
 
     Step getStep(int lane, int step) const {
         if (lane < 0 || lane >= kLanes) return Step{};
-        if (step < 0 || step >= kSteps) return Step{};
+        if (step < 0 || step >= kMaxSteps) return Step{};
         return steps[lane][step];
     }
 };
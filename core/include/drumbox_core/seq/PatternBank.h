@@ -0,0 +1,172 @@
+#pragma once
+#include "drumbox_core/Types.h"
+#include <memory>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace drumbox_core {
+
+// Indice du bit le plus bas (mask != 0)
+inline int lowestBit(u64 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, mask);
+    return (int)idx;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Banque de patterns : nombre de lanes et de patterns fixé au prepare(),
+// jusqu'à kMaxSteps steps par pattern, chaînage (mode song).
+//
+// Layout par pattern :
+// - laneMask[lane]  : bit s = step s actif (lecture/édition d'une lane)
+// - stepLanes[step] : bit l = lane l active à ce step (transposé, pour le séquenceur :
+//                     un step ne coûte que ses lanes actives)
+// - vel[lane][step] : vélocités (kMaxSteps par lane)
+//
+// Tout est alloué par prepare() (non temps réel) ; le reste ne fait qu'écrire dans
+// ces tableaux : à appeler depuis le thread audio (ou avant process()), sans verrou.
+class PatternBank
+{
+public:
+    static constexpr int kMaxChain = 256; // entrées du chaînage
+
+    void prepare(int numLanes, int numPatterns)
+    {
+        if (numLanes < 1) numLanes = 1;
+        if (numLanes > kMaxLanes) numLanes = kMaxLanes;
+        if (numPatterns < 1) numPatterns = 1;
+
+        if (numLanes != numLanes_ || numPatterns != numPatterns_)
+        {
+            numLanes_ = numLanes;
+            numPatterns_ = numPatterns;
+            slots_.reset(new Slot[(size_t)numPatterns]);
+            laneMask_.reset(new u64[(size_t)numPatterns * (size_t)numLanes]);
+            vel_.reset(new float[(size_t)numPatterns * (size_t)numLanes * kMaxSteps]);
+        }
+
+        for (int p = 0; p < numPatterns_; ++p)
+            clear(p);
+        chainLen_ = 0;
+    }
+
+    int numLanes() const { return numLanes_; }
+    int numPatterns() const { return numPatterns_; }
+    bool isValid(int pattern) const { return pattern >= 0 && pattern < numPatterns_; }
+
+    void clear(int pattern)
+    {
+        if (!isValid(pattern))
+            return;
+        Slot& s = slots_[pattern];
+        s.length = kSteps;
+        for (int i = 0; i < kMaxSteps; ++i)
+            s.stepLanes[i] = 0;
+        for (int l = 0; l < numLanes_; ++l)
+        {
+            lanes(pattern)[l] = 0;
+            float* v = velocities(pattern, l);
+            for (int i = 0; i < kMaxSteps; ++i)
+                v[i] = 1.0f;
+        }
+    }
+
+    // 1..kMaxSteps ; les steps au-delà de la longueur sont conservés (pas joués)
+    void setLength(int pattern, int steps)
+    {
+        if (!isValid(pattern))
+            return;
+        if (steps < 1) steps = 1;
+        if (steps > kMaxSteps) steps = kMaxSteps;
+        slots_[pattern].length = steps;
+    }
+
+    int length(int pattern) const { return isValid(pattern) ? slots_[pattern].length : kSteps; }
+
+    void setStep(int pattern, int lane, int step, bool on, float vel)
+    {
+        if (!isValid(pattern) || lane < 0 || lane >= numLanes_ || step < 0 || step >= kMaxSteps)
+            return;
+
+        const u64 stepBit = 1ull << step;
+        const u64 laneBit = 1ull << lane;
+        u64& mask = lanes(pattern)[lane];
+        u64& at = slots_[pattern].stepLanes[step];
+        if (on)
+        {
+            mask |= stepBit;
+            at |= laneBit;
+        }
+        else
+        {
+            mask &= ~stepBit;
+            at &= ~laneBit;
+        }
+        velocities(pattern, lane)[step] = vel;
+    }
+
+    bool isOn(int pattern, int lane, int step) const
+    {
+        if (!isValid(pattern) || lane < 0 || lane >= numLanes_ || step < 0 || step >= kMaxSteps)
+            return false;
+        return (laneMask_[(size_t)pattern * (size_t)numLanes_ + (size_t)lane] >> step) & 1u;
+    }
+
+    float velocity(int pattern, int lane, int step) const
+    {
+        return vel_[((size_t)pattern * (size_t)numLanes_ + (size_t)lane) * kMaxSteps + (size_t)step];
+    }
+
+    // Lanes actives à un step (bit l = lane l), pour le séquenceur
+    u64 lanesAt(int pattern, int step) const { return slots_[pattern].stepLanes[step]; }
+
+    // Steps actifs d'une lane (bit s = step s)
+    u64 laneSteps(int pattern, int lane) const
+    {
+        if (!isValid(pattern) || lane < 0 || lane >= numLanes_)
+            return 0;
+        return laneMask_[(size_t)pattern * (size_t)numLanes_ + (size_t)lane];
+    }
+
+    // Mode song : suite de patterns jouée en boucle. Les indices invalides sont ignorés.
+    void setChain(const int* patterns, int count)
+    {
+        chainLen_ = 0;
+        for (int i = 0; i < count && chainLen_ < kMaxChain; ++i)
+            if (isValid(patterns[i]))
+                chain_[chainLen_++] = patterns[i];
+    }
+
+    int chainLength() const { return chainLen_; }
+    int chainEntry(int i) const { return chain_[i]; }
+
+private:
+    struct Slot
+    {
+        int length = kSteps;
+        u64 stepLanes[kMaxSteps]{};
+    };
+
+    u64* lanes(int pattern) { return laneMask_.get() + (size_t)pattern * (size_t)numLanes_; }
+    float* velocities(int pattern, int lane)
+    {
+        return vel_.get() + ((size_t)pattern * (size_t)numLanes_ + (size_t)lane) * kMaxSteps;
+    }
+
+    int numLanes_ = 0;
+    int numPatterns_ = 0;
+    std::unique_ptr<Slot[]>  slots_;
+    std::unique_ptr<u64[]>   laneMask_;
+    std::unique_ptr<float[]> vel_;
+
+    int chain_[kMaxChain]{};
+    int chainLen_ = 0;
+};
+
+} // namespace drumbox_core
@@ -0,0 +1,55 @@
+// Drumbox/core/src/AllocTrap.cpp
+
+#include "drumbox_core/AllocTrap.h"
+
+#if defined(DRUMBOX_ALLOC_TRAP)
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace drumbox_core {
+namespace alloctrap {
+
+// profondeur de ScopedAllocTrap sur ce thread (les workers d'EngineGroup ont la leur)
+static thread_local int depth = 0;
+
+void enter() { ++depth; }
+void leave() { --depth; }
+
+static void check(const char* what)
+{
+    if (depth > 0)
+    {
+        depth = 0; // abort() peut encore passer par new (handlers)
+        std::fprintf(stderr, "drumbox: %s pendant Engine::process()\n", what);
+        std::abort();
+    }
+}
+
+} // namespace alloctrap
+} // namespace drumbox_core
+
+// Remplacement global : les autres formes (new[], nothrow, delete[]) passent par celles-ci.
+// Ce fichier est lié dès qu'Engine.cpp l'est (il référence enter/leave).
+void* operator new(std::size_t size)
+{
+    drumbox_core::alloctrap::check("allocation");
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p)
+        drumbox_core::alloctrap::check("libération");
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+#endif
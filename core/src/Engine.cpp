@@ -1,30 +1,72 @@
 // Drumbox/core/src/Engine.cpp
 
 #include "drumbox_core/Engine.h"
+#include "drumbox_core/AllocTrap.h"
+#include "drumbox_core/dsp/Denormals.h"
+#include "drumbox_core/dsp/Interleave.h"
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <cstring>
 
 namespace drumbox_core
 {
-    void Engine::clearPattern() { pattern_.clear(); }
+    void Engine::clearPattern() { patterns_.clear(curPattern_); }
+    void Engine::clearPattern(int pattern) { patterns_.clear(pattern); }
 
     void Engine::prepare(double sampleRate, int maxBlockSize)
     {
         sampleRate_ = sampleRate;
-        maxBlock_ = maxBlockSize;
+        maxBlock_ = std::max(1, maxBlockSize);
 
-        transport_.prepare(sampleRate_);
+        // buffers de travail : réalloués seulement si la taille change
+        const int subBlock = std::min(maxBlock_, kMaxSubBlock);
+        if (subBlock != subBlock_)
+        {
+            scratchMem_.reset(new float[(size_t)subBlock * Scratch::kNumBuffers]);
+            subBlock_ = subBlock;
+
+            float* p = scratchMem_.get();
+            for (float** buf : { &scratch_.kick, &scratch_.dry, &scratch_.wetL, &scratch_.wetR,
+                                 &scratch_.fxL, &scratch_.fxR, &scratch_.voice })
+            {
+                *buf = p;
+                p += subBlock;
+            }
+        }
 
-        kick_.prepare(sampleRate_);
-        snare_.prepare(sampleRate_);
-        hat_.prepare(sampleRate_);
+        transport_.prepare(sampleRate_);
 
-        reverb_.prepare((float)sampleRate_);
-        fx_.prepare((float)sampleRate_);
+        kicks_.prepare(sampleRate_);
+        snares_.prepare(sampleRate_);
+        hats_.prepare(sampleRate_);
+        kickCache_.prepare(sampleRate_, kickCacheEnabled_ ? kKickCacheSeconds : 0.0f);
+
+        // un seul bloc pour toutes les lignes à retard, dimensionné au sr max
+        const float arenaSr = (float)std::max(sampleRate_, maxSampleRate_);
+        size_t delayFloats = FxSection::requiredFloats(arenaSr);
+        if (reverbEnabled_)
+            delayFloats += ReverbSchroeder::requiredFloats(arenaSr);
+        arena_.reserve(delayFloats);
+
+        DelayArena none;
+        reverb_.prepare((float)sampleRate_, reverbEnabled_ ? arena_ : none);
+        fx_.prepare((float)sampleRate_, arena_);
         master_.prepare((float)sampleRate_);
+        cpu_.prepare(sampleRate_);
+
+        // UI part de zéro (tous les patterns vides), lecture depuis le pattern 0
+        patterns_.prepare(patternLanes_, patternCount_);
+        curPattern_ = 0;
+        queuedPattern_ = -1;
+        chainPos_ = -1;
+        playheadPattern_.store(0, std::memory_order_relaxed);
 
-        clearPattern(); // UI part de zéro
+        numEvents_ = 0;
+
+        // nouveau sample rate: tous les coeffs sont à recalculer
+        params_.markDirty(ParamGroup::All);
 
     }
 
@@ -56,238 +98,578 @@ namespace drumbox_core
             velocity = 0.0f;
         if (velocity > 1.0f)
             velocity = 1.0f;
-        pattern_.setStep(lane, step, on, velocity);
+        patterns_.setStep(curPattern_, lane, step, on, velocity);
+    }
+
+    void Engine::setStep(int pattern, int lane, int step, bool on, float velocity)
+    {
+        if (velocity < 0.0f)
+            velocity = 0.0f;
+        if (velocity > 1.0f)
+            velocity = 1.0f;
+        patterns_.setStep(pattern, lane, step, on, velocity);
+    }
+
+    void Engine::setPatternLength(int pattern, int steps)
+    {
+        patterns_.setLength(pattern, steps);
+    }
+
+    void Engine::queuePattern(int pattern)
+    {
+        if (patterns_.isValid(pattern))
+            queuedPattern_ = pattern;
+    }
+
+    void Engine::setSongChain(const int* patterns, int count)
+    {
+        patterns_.setChain(patterns, count);
+        chainPos_ = -1; // reprend au début de la chaîne
+    }
+
+    void Engine::setSongMode(bool on)
+    {
+        songMode_ = on;
+        chainPos_ = -1;
     }
 
     void Engine::triggerStep(int stepIndex)
     {
-        // lane 0 kick, 1 snare, 2 hat
-        const Step k = pattern_.getStep(0, stepIndex);
-        const Step s = pattern_.getStep(1, stepIndex);
-        const Step h = pattern_.getStep(2, stepIndex);
+        // pattern raccourci pendant la lecture : rien au-delà de la longueur
+        if (stepIndex >= patterns_.length(curPattern_))
+            return;
 
-        if (k.on)
+        // lanes actives à ce step uniquement (lane 0 kick, 1 snare, 2 hat)
+        u64 lanes = patterns_.lanesAt(curPattern_, stepIndex);
+        while (lanes != 0)
         {
-            kick_.trigger(k.vel);
-            fx_.triggerEnv(k.vel);
+            const int lane = lowestBit(lanes);
+            lanes &= lanes - 1;
+            triggerLane(lane, patterns_.velocity(curPattern_, lane, stepIndex));
         }
-        if (s.on)
-            snare_.trigger(s.vel);
-        if (h.on)
-            hat_.trigger(h.vel);
     }
 
-    void Engine::process(float *out, int numFrames, int numChannels)
+    void Engine::advanceStep()
     {
+        if (++transport_.stepIndex < patterns_.length(curPattern_))
+            return;
 
-        const float masterGain = params_.masterGain.load(std::memory_order_relaxed);
+        // fin du pattern : pattern demandé, sinon suivant de la chaîne, sinon boucle
+        transport_.stepIndex = 0;
+        if (queuedPattern_ >= 0)
+        {
+            curPattern_ = queuedPattern_;
+            queuedPattern_ = -1;
+        }
+        else if (songMode_ && patterns_.chainLength() > 0)
+        {
+            chainPos_ = (chainPos_ + 1) % patterns_.chainLength();
+            curPattern_ = patterns_.chainEntry(chainPos_);
+        }
+        playheadPattern_.store(curPattern_, std::memory_order_relaxed);
+    }
 
-        // Master params
-        const float eqLowDb  = params_.masterEqLowDb.load(std::memory_order_relaxed);
-        const float eqMidDb  = params_.masterEqMidDb.load(std::memory_order_relaxed);
-        const float eqHighDb = params_.masterEqHighDb.load(std::memory_order_relaxed);
-        const bool clipOn    = params_.masterClipOn.load(std::memory_order_relaxed) > 0.5f;
-        const int clipMode   = (int)params_.masterClipMode.load(std::memory_order_relaxed);
-        master_.setEqDb(eqLowDb, eqMidDb, eqHighDb);
-        master_.setClipper(clipOn, clipMode);
+    void Engine::triggerLane(int lane, float velocity)
+    {
+        switch (lane)
+        {
+            case 0:
+            {
+                Kick& kick = kicks_.trigger(velocity);
+                kickCache_.attach(kick, velocity, kick.isCacheable());
+                fx_.triggerEnv(velocity);
+                break;
+            }
+            case 1: snares_.trigger(velocity); break;
+            case 2: hats_.trigger(velocity); break;
+            default: break;
+        }
+    }
 
-        // Kick
-        kick_.ampEnv.setDecay(params_.kickDecay.load(std::memory_order_relaxed));
-        kick_.pitchEnv.setDecay(params_.kickPitchDecay.load(std::memory_order_relaxed));
-        kick_.driveEnv.setDecay(params_.kickDriveDecay.load(std::memory_order_relaxed));
+    bool Engine::pushEvent(int frameOffset, int lane, float velocity)
+    {
+        if (lane < 0 || lane >= kLanes || numEvents_ >= kMaxEvents)
+            return false;
 
-        kick_.attackFreq  = params_.kickAttackFreq.load(std::memory_order_relaxed);
-        kick_.baseFreq    = params_.kickBaseFreq.load(std::memory_order_relaxed);
+        if (frameOffset < 0)
+            frameOffset = 0;
+        if (velocity < 0.0f)
+            velocity = 0.0f;
+        if (velocity > 1.0f)
+            velocity = 1.0f;
 
-        kick_.driveAmount = params_.kickDriveAmount.load(std::memory_order_relaxed);
-        kick_.clickGain   = params_.kickClickGain.load(std::memory_order_relaxed);
-        kick_.postGain    = params_.kickPostGain.load(std::memory_order_relaxed);
+        // insertion triée (la file est courte, souvent déjà dans l'ordre)
+        int i = numEvents_;
+        while (i > 0 && events_[i - 1].frame > frameOffset)
+        {
+            events_[i] = events_[i - 1];
+            --i;
+        }
+        events_[i] = NoteEvent{ frameOffset, lane, velocity };
+        ++numEvents_;
+        return true;
+    }
 
-        kick_.preHpHz     = params_.kickPreHpHz.load(std::memory_order_relaxed);
-        kick_.preHP.setCutoff(kick_.preHpHz, (float)sampleRate_);
+    void Engine::drainCommands()
+    {
+        Command c;
+        for (int i = 0; i < kMaxCommandsPerBlock && commands_.pop(c); ++i)
+            applyCommand(c);
+    }
 
-        // Oversampling: si actif, la partie "disto/post" tourne en 2x (Kick::process)
-        kick_.oversample2x = params_.kickOversample2x.load(std::memory_order_relaxed) > 0.5f;
-        const float srDist = kick_.oversample2x ? (float)(2.0 * sampleRate_) : (float)sampleRate_;
+    void Engine::applyCommand(const Command& c)
+    {
+        switch (c.type)
+        {
+            case Command::SetStep:
+                setStep(c.pattern < 0 ? curPattern_ : c.pattern, c.lane, c.step, c.on, c.value);
+                break;
+            case Command::SetPatternLength:
+                setPatternLength(c.pattern < 0 ? curPattern_ : c.pattern, c.index);
+                break;
+            case Command::QueuePattern:
+                queuePattern(c.pattern);
+                break;
+            case Command::SetSongMode:
+                setSongMode(c.on);
+                break;
+            case Command::SetParam:
+                if (c.index >= 0 && c.index < kNumParams)
+                {
+                    params_.set(kParamInfo[c.index], c.value);
+                }
+                break;
+            case Command::Trigger:
+                pushEvent(c.frame, c.lane, c.value);
+                break;
+            case Command::SetBpm:
+                setBpm(c.value);
+                break;
+            case Command::SetPlaying:
+                setPlaying(c.on);
+                break;
+        }
+    }
 
-        kick_.postLpHz    = params_.kickPostLpHz.load(std::memory_order_relaxed);
-        kick_.postLP.setCutoff(kick_.postLpHz, srDist);
+    void Engine::applyParams(u32 dirty)
+    {
+        if (dirty & ParamGroup::Master)
+        {
+            master_.setGain(params_.masterGain.load(std::memory_order_relaxed));
+
+            const float eqLowDb  = params_.masterEqLowDb.load(std::memory_order_relaxed);
+            const float eqMidDb  = params_.masterEqMidDb.load(std::memory_order_relaxed);
+            const float eqHighDb = params_.masterEqHighDb.load(std::memory_order_relaxed);
+            const bool clipOn    = params_.masterClipOn.load(std::memory_order_relaxed) > 0.5f;
+            const int clipMode   = (int)params_.masterClipMode.load(std::memory_order_relaxed);
+            master_.setEqDb(eqLowDb, eqMidDb, eqHighDb);
+            master_.setClipper(clipOn, clipMode);
+        }
 
-        kick_.postHpHz    = params_.kickPostHpHz.load(std::memory_order_relaxed);
-        kick_.postHP.setCutoff(kick_.postHpHz, srDist);
+        // le son du kick change : coups en cache à re-rendre
+        if (dirty & (ParamGroup::Kick | ParamGroup::KickFilter | ParamGroup::KickLayers | ParamGroup::KickLfo))
+            kickCache_.invalidate();
 
-        kick_.clipMode    = (int)params_.kickClipMode.load(std::memory_order_relaxed);
+        if (dirty & ParamGroup::Kick)
+        {
+            kicks_.forEach([&](Kick& kick) {
+                kick.ampEnv.setDecay(params_.kickDecay.load(std::memory_order_relaxed));
+                kick.pitchEnv.setDecay(params_.kickPitchDecay.load(std::memory_order_relaxed));
+                kick.driveEnv.setDecay(params_.kickDriveDecay.load(std::memory_order_relaxed));
+
+                kick.attackFreq  = params_.kickAttackFreq.load(std::memory_order_relaxed);
+                kick.baseFreq    = params_.kickBaseFreq.load(std::memory_order_relaxed);
+
+                kick.driveAmount = params_.kickDriveAmount.load(std::memory_order_relaxed);
+                kick.clickGain   = params_.kickClickGain.load(std::memory_order_relaxed);
+                kick.postGain    = params_.kickPostGain.load(std::memory_order_relaxed);
+
+                kick.clipMode    = (int)params_.kickClipMode.load(std::memory_order_relaxed);
+                kick.mathMode    = (params_.kickMathMode.load(std::memory_order_relaxed) > 0.5f)
+                                     ? MathMode::Reference : MathMode::Fast;
+
+                float c1 = params_.kickChain1ClipMode.load(std::memory_order_relaxed);
+                float c2 = params_.kickChain2ClipMode.load(std::memory_order_relaxed);
+                if (c1 < -0.5f) c1 = (float)kick.clipMode;
+                if (c2 < -0.5f) c2 = (float)kick.clipMode;
+                kick.chain1ClipMode = (int)c1;
+                kick.chain2ClipMode = (int)c2;
+
+                kick.tokAmount    = params_.kickTokAmount.load(std::memory_order_relaxed);
+                kick.crunchAmount = params_.kickCrunchAmount.load(std::memory_order_relaxed);
+
+                kick.tailEnv.setDecay(params_.kickTailDecay.load(std::memory_order_relaxed));
+                kick.tailMix      = params_.kickTailMix.load(std::memory_order_relaxed);
+                kick.tailFreqMul  = params_.kickTailFreqMul.load(std::memory_order_relaxed);
+
+                kick.subMix       = params_.kickSubMix.load(std::memory_order_relaxed);
+                kick.feedback     = params_.kickFeedback.load(std::memory_order_relaxed);
+
+                kick.chain1Mix      = params_.kickChain1Mix.load(std::memory_order_relaxed);
+                kick.chain1DriveMul = params_.kickChain1DriveMul.load(std::memory_order_relaxed);
+                kick.chain1Asym     = params_.kickChain1Asym.load(std::memory_order_relaxed);
+
+                kick.chain2Mix      = params_.kickChain2Mix.load(std::memory_order_relaxed);
+                kick.chain2DriveMul = params_.kickChain2DriveMul.load(std::memory_order_relaxed);
+                kick.chain2Asym     = params_.kickChain2Asym.load(std::memory_order_relaxed);
+            });
+        }
 
+        if (dirty & ParamGroup::KickFilter)
         {
-            float c1 = params_.kickChain1ClipMode.load(std::memory_order_relaxed);
-            float c2 = params_.kickChain2ClipMode.load(std::memory_order_relaxed);
-            if (c1 < -0.5f) c1 = (float)kick_.clipMode;
-            if (c2 < -0.5f) c2 = (float)kick_.clipMode;
-            kick_.chain1ClipMode = (int)c1;
-            kick_.chain2ClipMode = (int)c2;
+            kicks_.forEach([&](Kick& kick) {
+                // Oversampling: la partie "disto/post" tourne en 2x/4x/8x (Kick::process)
+                const int osQuality = std::clamp((int)params_.kickOversample.load(std::memory_order_relaxed), 0, 3);
+                kick.oversampleFactor = 1 << osQuality;
+                const float srDist = (float)(sampleRate_ * (double)kick.oversampleFactor);
+
+                kick.preHpHz    = params_.kickPreHpHz.load(std::memory_order_relaxed);
+                kick.postLpHz   = params_.kickPostLpHz.load(std::memory_order_relaxed);
+                kick.postHpHz   = params_.kickPostHpHz.load(std::memory_order_relaxed);
+                kick.subLpHz    = params_.kickSubLpHz.load(std::memory_order_relaxed);
+                kick.tokHpHz    = params_.kickTokHpHz.load(std::memory_order_relaxed);
+                kick.chain1LpHz = params_.kickChain1LpHz.load(std::memory_order_relaxed);
+                kick.chain2LpHz = params_.kickChain2LpHz.load(std::memory_order_relaxed);
+
+                kick.preHP.setCutoff(kick.preHpHz, (float)sampleRate_);
+                kick.subLP.setCutoff(kick.subLpHz, (float)sampleRate_);
+                kick.postLP.setCutoff(kick.postLpHz, srDist);
+                kick.postHP.setCutoff(kick.postHpHz, srDist);
+                kick.tokHP.setCutoff(kick.tokHpHz, srDist);
+                kick.chain1LP.setCutoff(kick.chain1LpHz, srDist);
+                kick.chain2LP.setCutoff(kick.chain2LpHz, srDist);
+            });
         }
 
-        kick_.tokAmount   = params_.kickTokAmount.load(std::memory_order_relaxed);
-        kick_.tokHpHz     = params_.kickTokHpHz.load(std::memory_order_relaxed);
-        kick_.tokHP.setCutoff(kick_.tokHpHz, srDist);
-        kick_.crunchAmount = params_.kickCrunchAmount.load(std::memory_order_relaxed);
+        // Kick layers (2 mini synths)
+        if (dirty & ParamGroup::KickLayers)
+        {
+            kicks_.forEach([&](Kick& kick) {
+                kick.layer1Enabled     = params_.kickLayer1Enabled.load(std::memory_order_relaxed);
+                kick.layer1Type        = params_.kickLayer1Type.load(std::memory_order_relaxed);
+                kick.layer1FreqHz      = params_.kickLayer1FreqHz.load(std::memory_order_relaxed);
+                kick.layer1Phase01     = params_.kickLayer1Phase01.load(std::memory_order_relaxed);
+                kick.layer1Drive       = params_.kickLayer1Drive.load(std::memory_order_relaxed);
+                kick.layer1AttackCoeff = params_.kickLayer1AttackCoeff.load(std::memory_order_relaxed);
+                kick.layer1DecayCoeff  = params_.kickLayer1DecayCoeff.load(std::memory_order_relaxed);
+                kick.layer1Vol         = params_.kickLayer1Vol.load(std::memory_order_relaxed);
+
+                kick.layer2Enabled     = params_.kickLayer2Enabled.load(std::memory_order_relaxed);
+                kick.layer2Type        = params_.kickLayer2Type.load(std::memory_order_relaxed);
+                kick.layer2FreqHz      = params_.kickLayer2FreqHz.load(std::memory_order_relaxed);
+                kick.layer2Phase01     = params_.kickLayer2Phase01.load(std::memory_order_relaxed);
+                kick.layer2Drive       = params_.kickLayer2Drive.load(std::memory_order_relaxed);
+                kick.layer2AttackCoeff = params_.kickLayer2AttackCoeff.load(std::memory_order_relaxed);
+                kick.layer2DecayCoeff  = params_.kickLayer2DecayCoeff.load(std::memory_order_relaxed);
+                kick.layer2Vol         = params_.kickLayer2Vol.load(std::memory_order_relaxed);
+            });
+        }
 
-        kick_.tailEnv.setDecay(params_.kickTailDecay.load(std::memory_order_relaxed));
-        kick_.tailMix      = params_.kickTailMix.load(std::memory_order_relaxed);
-        kick_.tailFreqMul  = params_.kickTailFreqMul.load(std::memory_order_relaxed);
+        if (dirty & ParamGroup::KickLfo)
+        {
+            kicks_.forEach([&](Kick& kick) {
+                kick.lfoAmount = params_.kickLfoAmount.load(std::memory_order_relaxed);
+                kick.lfoRateHz = params_.kickLfoRateHz.load(std::memory_order_relaxed);
+                kick.lfoShape  = params_.kickLfoShape.load(std::memory_order_relaxed);
+                kick.lfoTarget = params_.kickLfoTarget.load(std::memory_order_relaxed);
+                kick.lfoPulse  = params_.kickLfoPulse.load(std::memory_order_relaxed);
+            });
+        }
 
-        kick_.subMix       = params_.kickSubMix.load(std::memory_order_relaxed);
-        kick_.subLpHz      = params_.kickSubLpHz.load(std::memory_order_relaxed);
-        kick_.subLP.setCutoff(kick_.subLpHz, (float)sampleRate_);
+        if (dirty & ParamGroup::Reverb)
+        {
+            const float revAmt  = params_.kickReverbAmount.load(std::memory_order_relaxed);
+            const float revSize = params_.kickReverbSize.load(std::memory_order_relaxed);
+            const float revTone = params_.kickReverbTone.load(std::memory_order_relaxed);
+            reverb_.setParams(revAmt, revSize, revTone);
+        }
 
-        kick_.feedback     = params_.kickFeedback.load(std::memory_order_relaxed);
+        if (dirty & ParamGroup::Fx)
+        {
+            const float fxShift  = params_.kickFxShiftHz.load(std::memory_order_relaxed);
+            const float fxStereo = params_.kickFxStereo.load(std::memory_order_relaxed);
+            const float fxDiff   = params_.kickFxDiffusion.load(std::memory_order_relaxed);
+            const float fxCD     = params_.kickFxCleanDirty.load(std::memory_order_relaxed);
+            const float fxTone   = params_.kickFxTone.load(std::memory_order_relaxed);
+            const float fxEnvA   = params_.kickFxEnvAttackCoeff.load(std::memory_order_relaxed);
+            const float fxEnvD   = params_.kickFxEnvDecayCoeff.load(std::memory_order_relaxed);
+            const float fxEnvV   = params_.kickFxEnvVol.load(std::memory_order_relaxed);
+            const float fxDisp   = params_.kickFxDisperse.load(std::memory_order_relaxed);
+            const float fxInf    = params_.kickFxInflator.load(std::memory_order_relaxed);
+            const float fxMix    = params_.kickFxInflatorMix.load(std::memory_order_relaxed);
+            const float fxOtt    = params_.kickFxOttAmount.load(std::memory_order_relaxed);
+            fx_.setShiftHz(fxShift);
+            fx_.setStereo(fxStereo);
+            fx_.setDiffusion(fxDiff);
+            fx_.setCleanDirty(fxCD);
+            fx_.setTone(fxTone);
+            fx_.setEnv(fxEnvA, fxEnvD, fxEnvV);
+            fx_.setDisperse(fxDisp);
+            fx_.setInflator(fxInf, fxMix);
+            fx_.setOtt(fxOtt);
+        }
 
-        kick_.chain1Mix      = params_.kickChain1Mix.load(std::memory_order_relaxed);
-        kick_.chain1DriveMul = params_.kickChain1DriveMul.load(std::memory_order_relaxed);
-        kick_.chain1LpHz     = params_.kickChain1LpHz.load(std::memory_order_relaxed);
-        kick_.chain1Asym     = params_.kickChain1Asym.load(std::memory_order_relaxed);
-        kick_.chain1LP.setCutoff(kick_.chain1LpHz, srDist);
+        if (dirty & ParamGroup::Snare)
+        {
+            snares_.forEach([&](Snare& snare) {
+                snare.ampEnv.setDecay(params_.snareDecay.load(std::memory_order_relaxed));
+                snare.toneFreq = params_.snareToneFreq.load(std::memory_order_relaxed);
+                snare.noiseMix = params_.snareNoiseMix.load(std::memory_order_relaxed);
+            });
+        }
 
-        kick_.chain2Mix      = params_.kickChain2Mix.load(std::memory_order_relaxed);
-        kick_.chain2DriveMul = params_.kickChain2DriveMul.load(std::memory_order_relaxed);
-        kick_.chain2LpHz     = params_.kickChain2LpHz.load(std::memory_order_relaxed);
-        kick_.chain2Asym     = params_.kickChain2Asym.load(std::memory_order_relaxed);
-        kick_.chain2LP.setCutoff(kick_.chain2LpHz, srDist);
+        if (dirty & ParamGroup::Hat)
+        {
+            hats_.forEach([&](HiHat& hat) {
+                hat.ampEnv.setDecay(params_.hatDecay.load(std::memory_order_relaxed));
+                hat.cutoff = params_.hatCutoff.load(std::memory_order_relaxed);
+                hat.updateFilterIfNeeded((float)sampleRate_);
+            });
+        }
+    }
 
-        kick_.tokAmount      = params_.kickTokAmount.load(std::memory_order_relaxed);
-        kick_.tokHpHz        = params_.kickTokHpHz.load(std::memory_order_relaxed);
-        kick_.tokHP.setCutoff(kick_.tokHpHz, srDist);
+    void Engine::process(float *out, int numFrames, int numChannels)
+    {
+        Output o;
+        o.interleaved = out;
+        o.numChannels = numChannels;
+        render(o, numFrames);
+    }
 
-        kick_.crunchAmount   = params_.kickCrunchAmount.load(std::memory_order_relaxed);
+    void Engine::processPlanar(float* const* channels, int numChannels, int numFrames)
+    {
+        Output o;
+        o.planar = channels;
+        o.numChannels = numChannels;
+        render(o, numFrames);
+    }
 
-        // Kick layers (2 mini synths)
-        kick_.layer1Enabled     = params_.kickLayer1Enabled.load(std::memory_order_relaxed);
-        kick_.layer1Type        = params_.kickLayer1Type.load(std::memory_order_relaxed);
-        kick_.layer1FreqHz      = params_.kickLayer1FreqHz.load(std::memory_order_relaxed);
-        kick_.layer1Phase01     = params_.kickLayer1Phase01.load(std::memory_order_relaxed);
-        kick_.layer1Drive       = params_.kickLayer1Drive.load(std::memory_order_relaxed);
-        kick_.layer1AttackCoeff = params_.kickLayer1AttackCoeff.load(std::memory_order_relaxed);
-        kick_.layer1DecayCoeff  = params_.kickLayer1DecayCoeff.load(std::memory_order_relaxed);
-        kick_.layer1Vol         = params_.kickLayer1Vol.load(std::memory_order_relaxed);
-
-        kick_.layer2Enabled     = params_.kickLayer2Enabled.load(std::memory_order_relaxed);
-        kick_.layer2Type        = params_.kickLayer2Type.load(std::memory_order_relaxed);
-        kick_.layer2FreqHz      = params_.kickLayer2FreqHz.load(std::memory_order_relaxed);
-        kick_.layer2Phase01     = params_.kickLayer2Phase01.load(std::memory_order_relaxed);
-        kick_.layer2Drive       = params_.kickLayer2Drive.load(std::memory_order_relaxed);
-        kick_.layer2AttackCoeff = params_.kickLayer2AttackCoeff.load(std::memory_order_relaxed);
-        kick_.layer2DecayCoeff  = params_.kickLayer2DecayCoeff.load(std::memory_order_relaxed);
-        kick_.layer2Vol         = params_.kickLayer2Vol.load(std::memory_order_relaxed);
-
-        // Kick LFO
-        kick_.lfoAmount = params_.kickLfoAmount.load(std::memory_order_relaxed);
-        kick_.lfoRateHz = params_.kickLfoRateHz.load(std::memory_order_relaxed);
-        kick_.lfoShape  = params_.kickLfoShape.load(std::memory_order_relaxed);
-        kick_.lfoTarget = params_.kickLfoTarget.load(std::memory_order_relaxed);
-        kick_.lfoPulse  = params_.kickLfoPulse.load(std::memory_order_relaxed);
-
-        // Kick Reverb
-        const float revAmt  = params_.kickReverbAmount.load(std::memory_order_relaxed);
-        const float revSize = params_.kickReverbSize.load(std::memory_order_relaxed);
-        const float revTone = params_.kickReverbTone.load(std::memory_order_relaxed);
-        reverb_.setParams(revAmt, revSize, revTone);
-
-        // Kick FX
-        const float fxShift = params_.kickFxShiftHz.load(std::memory_order_relaxed);
-        const float fxStereo = params_.kickFxStereo.load(std::memory_order_relaxed);
-        const float fxDiff   = params_.kickFxDiffusion.load(std::memory_order_relaxed);
-        const float fxCD     = params_.kickFxCleanDirty.load(std::memory_order_relaxed);
-        const float fxTone   = params_.kickFxTone.load(std::memory_order_relaxed);
-        const float fxEnvA   = params_.kickFxEnvAttackCoeff.load(std::memory_order_relaxed);
-        const float fxEnvD   = params_.kickFxEnvDecayCoeff.load(std::memory_order_relaxed);
-        const float fxEnvV   = params_.kickFxEnvVol.load(std::memory_order_relaxed);
-        const float fxDisp = params_.kickFxDisperse.load(std::memory_order_relaxed);
-        const float fxInf  = params_.kickFxInflator.load(std::memory_order_relaxed);
-        const float fxMix  = params_.kickFxInflatorMix.load(std::memory_order_relaxed);
-        const float fxOtt  = params_.kickFxOttAmount.load(std::memory_order_relaxed);
-        fx_.setShiftHz(fxShift);
-        fx_.setStereo(fxStereo);
-        fx_.setDiffusion(fxDiff);
-        fx_.setCleanDirty(fxCD);
-        fx_.setTone(fxTone);
-        fx_.setEnv(fxEnvA, fxEnvD, fxEnvV);
-        fx_.setDisperse(fxDisp);
-        fx_.setInflator(fxInf, fxMix);
-        fx_.setOtt(fxOtt);
-
-
-        // Snare
-        snare_.ampEnv.setDecay(params_.snareDecay.load(std::memory_order_relaxed));
-        snare_.toneFreq = params_.snareToneFreq.load(std::memory_order_relaxed);
-        snare_.noiseMix = params_.snareNoiseMix.load(std::memory_order_relaxed);
-
-        // Hat
-        hat_.ampEnv.setDecay(params_.hatDecay.load(std::memory_order_relaxed));
-        hat_.cutoff = params_.hatCutoff.load(std::memory_order_relaxed);
-        hat_.updateFilterIfNeeded((float)sampleRate_);
-
-
-
-        // clear
-        std::fill(out, out + (u64)numFrames * (u64)numChannels, 0.0f);
-
-        if (!transport_.playing)
+    void Engine::render(const Output& out, int numFrames)
+    {
+        // charge CPU : tout le callback, params et séquenceur compris
+        const u64 t0 = cpuTicks();
+
+        // FTZ/DAZ pour tout le rendu (restauré en sortie)
+        ScopedNoDenormals noDenormals;
+
+        // build DRUMBOX_ALLOC_TRAP : abort() si le rendu alloue
+        ScopedAllocTrap noAlloc;
+
+        // Commandes des front ends (avant les params : un SetParam compte dès ce bloc)
+        drainCommands();
+
+        // Params: une seule lecture atomique si rien n'a bougé depuis le bloc précédent
+        const u32 gen = params_.generation.load(std::memory_order_acquire);
+        if (gen != paramGeneration_)
+        {
+            paramGeneration_ = gen;
+            applyParams(params_.consumeDirty());
+        }
+
+        const bool playing = transport_.playing;
+
+        // Arrêté et plus rien qui sonne (voix, queues reverb/FX/master): silence.
+        // Sinon les voix (events externes, queues après stop) continuent d'être rendues.
+        // Pas encore préparé (aucun buffer de travail) : silence aussi.
+        if (subBlock_ == 0
+            || (!playing && numEvents_ == 0 && !voicesActive()
+                && reverb_.isSilent() && fx_.isSilent() && master_.isSilent()))
+        {
+            if (out.planar)
+            {
+                for (int c = 0; c < out.numChannels; ++c)
+                    std::memset(out.planar[c], 0, (size_t)numFrames * sizeof(float));
+            }
+            else
+            {
+                std::fill(out.interleaved, out.interleaved + (u64)numFrames * (u64)out.numChannels, 0.0f);
+            }
+            cpu_.endBlock(t0, numFrames);
             return;
-        
-        playheadStep_.store(transport_.stepIndex, std::memory_order_relaxed);
+        }
+
+        if (playing)
+            playheadStep_.store(transport_.stepIndex, std::memory_order_relaxed);
 
         const double fps = transport_.framesPerStep();
 
-        for (int f = 0; f < numFrames; ++f)
+        // Rendu par sous-blocs: on coupe aux frontières de step, aux events
+        // externes et à subBlock_, puis chaque étage traite le sous-bloc entier.
+        // Un bloc host plus grand que maxBlockSize est simplement découpé ici.
+        int f = 0;
+        int ev = 0;
+        while (f < numFrames)
         {
             // Step trigger timing
-            if ((double)transport_.currentFrame >= transport_.nextStepFrame)
+            if (playing && (double)transport_.currentFrame >= transport_.nextStepFrame)
             {
                 triggerStep(transport_.stepIndex);
-                transport_.stepIndex = (transport_.stepIndex + 1) % kSteps;
+                advanceStep();
                 playheadStep_.store(transport_.stepIndex, std::memory_order_relaxed);
                 transport_.nextStepFrame += fps;
+            }
 
+            // Events externes à ce frame
+            while (ev < numEvents_ && events_[ev].frame <= f)
+            {
+                triggerLane(events_[ev].lane, events_[ev].vel);
+                ++ev;
             }
-            transport_.currentFrame++;
-
-            // synth mix (dry mono)
-            const float k = kick_.process((float)sampleRate_);
-            const float s = snare_.process((float)sampleRate_);
-            const float h = hat_.process((float)sampleRate_);
-            const float dry = k + s + h;
-
-            // Reverb sur le kick (wet stéréo)
-            float wetL = 0.0f;
-            float wetR = 0.0f;
-            reverb_.processMono(k, wetL, wetR);
-
-            float yL = dry + wetL;
-            float yR = dry + wetR;
-
-            // FX (disperse/inflator)
-            float fxL = 0.0f;
-            float fxR = 0.0f;
-            fx_.process(yL, yR, fxL, fxR);
-
-            // Master (EQ + gain + clip)
-            float outL = 0.0f;
-            float outR = 0.0f;
-            master_.process(fxL, fxR, masterGain, outL, outR);
-
-            // write to output
-            if (numChannels == 1)
+
+            int n = numFrames - f;
+            if (n > subBlock_)
+                n = subBlock_;
+
+            if (playing)
             {
-                out[f] = 0.5f * (outL + outR);
+                // premier frame >= nextStepFrame
+                const double toNext = std::ceil(transport_.nextStepFrame - (double)transport_.currentFrame);
+                if (toNext < (double)n)
+                    n = (int)toNext;
             }
-            else
+
+            if (ev < numEvents_ && events_[ev].frame - f < n)
+                n = events_[ev].frame - f;
+
+            renderSubBlock(out, f, n);
+
+            if (playing)
+                transport_.currentFrame += (u64)n;
+            f += n;
+        }
+
+        // Events au-delà du bloc: reportés (offset relatif au bloc suivant)
+        int kept = 0;
+        for (int i = ev; i < numEvents_; ++i)
+        {
+            events_[kept] = events_[i];
+            events_[kept].frame -= numFrames;
+            ++kept;
+        }
+        numEvents_ = kept;
+
+        cpu_.endBlock(t0, numFrames);
+    }
+
+    void Engine::renderSubBlock(const Output& out, int offset, int n)
+    {
+        float* kick = scratch_.kick;
+        float* dry  = scratch_.dry;
+        float* wetL = scratch_.wetL;
+        float* wetR = scratch_.wetR;
+        float* fxL  = scratch_.fxL;
+        float* fxR  = scratch_.fxR;
+        float* tmp  = scratch_.voice;
+
+        u64 t = cpuTicks();
+
+        // Etages silencieux (entrée nulle + queue éteinte) : sautés, sortie à zéro.
+        const size_t bytes = (size_t)n * sizeof(float);
+        const bool kickOn = kicks_.isActive();
+        const bool dryOn = kickOn || snares_.isActive() || hats_.isActive();
+
+        // synth mix (dry mono) - fxL sert de buffer temporaire pour le hat
+        if (dryOn)
+        {
+            kicks_.processBlock(kick, tmp, n);
+            snares_.processBlock(dry, tmp, n);
+            hats_.processBlock(fxL, tmp, n);
+            for (int i = 0; i < n; ++i)
+                dry[i] = kick[i] + dry[i] + fxL[i];
+        }
+        t = cpu_.lap(CpuMeter::Voices, t);
+
+        // Reverb sur le kick (wet stéréo)
+        const bool wetOn = reverb_.isReady() && (kickOn || !reverb_.isSilent());
+        if (wetOn)
+        {
+            if (!dryOn)
+                std::memset(kick, 0, bytes); // queue seule
+            reverb_.processBlock(kick, wetL, wetR, n);
+        }
+
+        if (dryOn && wetOn)
+        {
+            for (int i = 0; i < n; ++i)
             {
-                out[f * numChannels + 0] = outL;
-                out[f * numChannels + 1] = outR;
-                for (int c = 2; c < numChannels; ++c)
-                    out[f * numChannels + c] = 0.5f * (outL + outR);
+                wetL[i] = dry[i] + wetL[i];
+                wetR[i] = dry[i] + wetR[i];
             }
         }
+        else if (dryOn)
+        {
+            std::memcpy(wetL, dry, bytes);
+            std::memcpy(wetR, dry, bytes);
+        }
+        else if (!wetOn)
+        {
+            std::memset(wetL, 0, bytes);
+            std::memset(wetR, 0, bytes);
+        }
+
+        t = cpu_.lap(CpuMeter::Reverb, t);
+
+        // FX (disperse/inflator)
+        const bool fxOn = dryOn || wetOn || !fx_.isSilent();
+        if (fxOn)
+        {
+            fx_.processBlock(wetL, wetR, fxL, fxR, n);
+        }
+        else
+        {
+            std::memset(fxL, 0, bytes);
+            std::memset(fxR, 0, bytes);
+        }
+
+        t = cpu_.lap(CpuMeter::Fx, t);
+
+        // Master (EQ + gain lissé + clip). En planar stéréo il écrit directement
+        // dans les canaux du host ; sinon en place, puis writeOutput().
+        const bool direct = out.planar && out.numChannels >= 2;
+        float* outL = direct ? out.planar[0] + offset : fxL;
+        float* outR = direct ? out.planar[1] + offset : fxR;
+
+        if (fxOn || !master_.isSilent())
+        {
+            master_.processBlock(fxL, fxR, outL, outR, n);
+        }
+        else if (direct)
+        {
+            std::memset(outL, 0, bytes);
+            std::memset(outR, 0, bytes);
+        }
+
+        writeOutput(out, offset, n);
+        cpu_.lap(CpuMeter::Master, t);
+    }
+
+    void Engine::writeOutput(const Output& out, int offset, int n)
+    {
+        const int ch = out.numChannels;
+
+        if (out.interleaved)
+        {
+            interleave(scratch_.fxL, scratch_.fxR, out.interleaved + (u64)offset * (u64)ch, n, ch);
+            return;
+        }
+
+        if (ch == 1)
+        {
+            float* dst = out.planar[0] + offset;
+            for (int i = 0; i < n; ++i)
+                dst[i] = 0.5f * (scratch_.fxL[i] + scratch_.fxR[i]);
+            return;
+        }
+
+        // L/R déjà écrits par le master ; canaux supplémentaires = (L+R)/2
+        const float* l = out.planar[0] + offset;
+        const float* r = out.planar[1] + offset;
+        for (int c = 2; c < ch; ++c)
+        {
+            float* dst = out.planar[c] + offset;
+            for (int i = 0; i < n; ++i)
+                dst[i] = 0.5f * (l[i] + r[i]);
+        }
     }
 
 } // namespace drumbox_core
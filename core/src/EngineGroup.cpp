@@ -0,0 +1,278 @@
+// Drumbox/core/src/EngineGroup.cpp
+
+#include "drumbox_core/EngineGroup.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(_WIN32)
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+  #include <emmintrin.h>
+#endif
+
+namespace drumbox_core
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Attente active sans transaction mémoire inutile
+        inline void cpuRelax()
+        {
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+            _mm_pause();
+#endif
+        }
+
+        // Best effort : peut échouer sans privilèges, on continue alors en priorité normale.
+        void setRealtimePriority()
+        {
+#if defined(_WIN32)
+            SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+#else
+            sched_param sp{};
+            sp.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+            pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+#endif
+        }
+
+        constexpr int kSpinCount = 4000;                 // pauses avant yield
+        constexpr auto kSleepAfter = std::chrono::milliseconds(50); // inactivité avant de dormir
+    }
+
+    EngineGroup::~EngineGroup()
+    {
+        release();
+    }
+
+    void EngineGroup::prepare(int numEngines, double sampleRate, int maxBlockSize,
+                              int numWorkers, int maxChannels)
+    {
+        release();
+
+        numEngines_ = std::max(0, numEngines);
+        sampleRate_ = sampleRate;
+        maxBlock_ = std::max(1, maxBlockSize);
+        maxChannels_ = std::max(2, maxChannels); // au moins L/R : les canaux en plus en dérivent
+        bufferStride_ = maxBlock_ * maxChannels_;
+
+        engines_.reset(new Engine[(size_t)numEngines_]);
+        stats_.reset(new InstanceStats[(size_t)numEngines_]);
+        buffers_.assign((size_t)numEngines_ * (size_t)bufferStride_, 0.0f);
+
+        for (int i = 0; i < numEngines_; ++i)
+            engines_[(size_t)i].prepare(sampleRate_, maxBlock_);
+
+        quit_.store(false);
+        epoch_.store(0);
+        nextIndex_.store(numEngines_);
+        doneCount_.store(numEngines_);
+
+        // pas plus de workers que d'Engines à partager avec l'appelant,
+        // ni que de coeurs libres (un worker qui attend son coeur bloque tout le bloc)
+        const int cores = std::max(1, (int)std::thread::hardware_concurrency());
+        const int maxWorkers = std::max(0, std::min(numEngines_ - 1, cores - 1));
+        const int workers = std::clamp(numWorkers, 0, maxWorkers);
+        workers_.reserve((size_t)workers);
+        for (int w = 0; w < workers; ++w)
+            workers_.emplace_back([this] { workerLoop(); });
+    }
+
+    void EngineGroup::release()
+    {
+        quit_.store(true);
+        {
+            std::lock_guard<std::mutex> lk(sleepMutex_);
+        }
+        sleepCv_.notify_all();
+
+        for (auto& t : workers_)
+            t.join();
+        workers_.clear();
+
+        engines_.reset();
+        stats_.reset();
+        buffers_.clear();
+        numEngines_ = 0;
+    }
+
+    u64 EngineGroup::lastProcessNs(int index) const
+    {
+        if (index < 0 || index >= numEngines_) return 0;
+        return stats_[(size_t)index].lastNs.load(std::memory_order_relaxed);
+    }
+
+    float EngineGroup::cpuLoad(int index) const
+    {
+        if (index < 0 || index >= numEngines_) return 0.0f;
+        return stats_[(size_t)index].load.load(std::memory_order_relaxed);
+    }
+
+    void EngineGroup::workerLoop()
+    {
+        setRealtimePriority();
+
+        u32 seen = epoch_.load(std::memory_order_acquire);
+        int spins = 0;
+        auto idleSince = Clock::now();
+
+        while (!quit_.load(std::memory_order_relaxed))
+        {
+            const u32 e = epoch_.load(std::memory_order_acquire);
+            if (e != seen)
+            {
+                seen = e;
+                runJobs();
+                spins = 0;
+                idleSince = Clock::now();
+                continue;
+            }
+
+            if (spins < kSpinCount)
+            {
+                ++spins;
+                cpuRelax();
+                continue;
+            }
+
+            if (Clock::now() - idleSince < kSleepAfter)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Longue inactivité (transport coupé, device arrêté...) : on dort.
+            std::unique_lock<std::mutex> lk(sleepMutex_);
+            sleepers_.fetch_add(1);
+            sleepCv_.wait(lk, [&] {
+                return quit_.load(std::memory_order_relaxed) || epoch_.load() != seen;
+            });
+            sleepers_.fetch_sub(1);
+            spins = 0;
+            idleSince = Clock::now();
+        }
+    }
+
+    void EngineGroup::runJobs()
+    {
+        for (;;)
+        {
+            const int i = nextIndex_.fetch_add(1, std::memory_order_acq_rel);
+            if (i >= numEngines_)
+                break;
+
+            renderOne(i);
+            doneCount_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void EngineGroup::renderOne(int index)
+    {
+        float* buf = buffers_.data() + (size_t)index * (size_t)bufferStride_;
+
+        const auto t0 = Clock::now();
+        engines_[(size_t)index].process(buf, jobFrames_, jobChannels_);
+        const u64 ns = (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+
+        InstanceStats& st = stats_[(size_t)index];
+        st.lastNs.store(ns, std::memory_order_relaxed);
+
+        const double blockNs = 1.0e9 * (double)jobFrames_ / sampleRate_;
+        const float load = (float)((double)ns / blockNs);
+        const float prev = st.load.load(std::memory_order_relaxed);
+        st.load.store(prev + 0.1f * (load - prev), std::memory_order_relaxed);
+    }
+
+    void EngineGroup::process(float* out, int numFrames, int numChannels)
+    {
+        // canaux au-delà de maxChannels : rendus comme Engine, (L+R)/2 du bus de mix
+        const int ch = std::min(numChannels, maxChannels_);
+
+        if (numEngines_ == 0)
+        {
+            std::fill(out, out + (u64)numFrames * (u64)numChannels, 0.0f);
+            return;
+        }
+
+        // blocs plus grands que maxBlock : découpés
+        int f = 0;
+        while (f < numFrames)
+        {
+            const int n = std::min(numFrames - f, maxBlock_);
+
+            // publication du job puis réveil des workers
+            jobFrames_ = n;
+            jobChannels_ = ch;
+            doneCount_.store(0, std::memory_order_relaxed);
+            nextIndex_.store(0, std::memory_order_release);
+            // seq_cst : ordre store(epoch) / load(sleepers) face au worker qui s'endort
+            epoch_.fetch_add(1);
+
+            if (sleepers_.load() > 0)
+            {
+                // rare : uniquement après une longue pause
+                {
+                    std::lock_guard<std::mutex> lk(sleepMutex_);
+                }
+                sleepCv_.notify_all();
+            }
+
+            // l'appelant prend sa part, puis attend les retardataires
+            runJobs();
+            for (int spins = 0; doneCount_.load(std::memory_order_acquire) < numEngines_; ++spins)
+            {
+                if (spins < kSpinCount)
+                    cpuRelax();
+                else
+                    std::this_thread::yield(); // worker préempté : on lui laisse le coeur
+            }
+
+            // bus de mix : somme dans l'ordre des index (déterministe)
+            float* dst = out + (u64)f * (u64)numChannels;
+            if (ch == numChannels)
+            {
+                const int count = n * ch;
+                std::copy(buffers_.data(), buffers_.data() + count, dst);
+                for (int e = 1; e < numEngines_; ++e)
+                {
+                    const float* src = buffers_.data() + (size_t)e * (size_t)bufferStride_;
+                    for (int k = 0; k < count; ++k)
+                        dst[k] += src[k];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    float* d = dst + (size_t)i * (size_t)numChannels;
+                    for (int c = 0; c < ch; ++c)
+                        d[c] = buffers_[(size_t)i * (size_t)ch + (size_t)c];
+                    for (int e = 1; e < numEngines_; ++e)
+                    {
+                        const float* src = buffers_.data() + (size_t)e * (size_t)bufferStride_ + (size_t)i * (size_t)ch;
+                        for (int c = 0; c < ch; ++c)
+                            d[c] += src[c];
+                    }
+                    const float mid = 0.5f * (d[0] + d[1]);
+                    for (int c = ch; c < numChannels; ++c)
+                        d[c] = mid;
+                }
+            }
+
+            f += n;
+        }
+    }
+
+} // namespace drumbox_core
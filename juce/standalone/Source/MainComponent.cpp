@@ -27,7 +27,7 @@ MainComponent::MainComponent()
         const bool newPlay = !playing.load();
         playing.store(newPlay);
 
-        queue.push(Command::setPlaying(newPlay));
+        engine.pushCommand(drumbox_core::Command::setPlaying(newPlay));
 
         playButton.setButtonText(newPlay ? "Stop" : "Play");
     };
@@ -39,7 +39,7 @@ MainComponent::MainComponent()
     bpmSlider.setValue(120.0);
     bpmSlider.onValueChange = [this]
     {
-        queue.push(Command::setBpm((float)bpmSlider.getValue()));
+        engine.pushCommand(drumbox_core::Command::setBpm((float)bpmSlider.getValue()));
     };
     addAndMakeVisible(bpmSlider);
 
@@ -47,6 +47,11 @@ MainComponent::MainComponent()
     masterLabel.setText("Master", juce::dontSendNotification);
     addAndMakeVisible(masterLabel);
 
+    // CPU
+    cpuLabel.setText("CPU -", juce::dontSendNotification);
+    cpuLabel.setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+    addAndMakeVisible(cpuLabel);
+
     // UI en dB (converti vers gain linéaire pour le core)
     auto dbFromLinear = [](double lin) {
         lin = std::max(1.0e-9, lin);
@@ -67,7 +72,7 @@ MainComponent::MainComponent()
     masterSlider.onValueChange = [this]
     {
         const double lin = std::pow(10.0, masterSlider.getValue() / 20.0);
-        engine.params().masterGain.store((float)lin, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::masterGain, (float)lin);
     };
     addAndMakeVisible(masterSlider);
 
@@ -132,587 +137,591 @@ MainComponent::MainComponent()
     
     drumControlPanel.onDecayChanged = [this](int lane, float value) {
         if (lane == 0)
-            engine.params().kickDecay.store(value, std::memory_order_relaxed);
+            engine.params().set(&drumbox_core::Params::kickDecay, value);
         else if (lane == 1)
-            engine.params().snareDecay.store(value, std::memory_order_relaxed);
+            engine.params().set(&drumbox_core::Params::snareDecay, value);
         else if (lane == 2)
-            engine.params().hatDecay.store(value, std::memory_order_relaxed);
+            engine.params().set(&drumbox_core::Params::hatDecay, value);
         
         if (drumWavePreview)
             drumWavePreview->rerender();
     };
     
     drumControlPanel.onKickAttackChanged = [this](float value) {
-        engine.params().kickAttackFreq.store(value, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickAttackFreq, value);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     
     drumControlPanel.onKickPitchChanged = [this](float value) {
-        engine.params().kickBaseFreq.store(value, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickBaseFreq, value);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickPitchDecayChanged = [this](float v) {
-        engine.params().kickPitchDecay.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickPitchDecay, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickDriveChanged = [this](float v) {
-        engine.params().kickDriveAmount.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickDriveAmount, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickDriveDecayChanged = [this](float v) {
-        engine.params().kickDriveDecay.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickDriveDecay, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickClickChanged = [this](float v) {
-        engine.params().kickClickGain.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickClickGain, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickHpChanged = [this](float v) {
-        engine.params().kickPreHpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickPreHpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickPostGainChanged = [this](float v) {
-        engine.params().kickPostGain.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickPostGain, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickPostHpChanged = [this](float v) {
-        engine.params().kickPostHpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickPostHpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickPostLpChanged = [this](float v) {
-        engine.params().kickPostLpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickPostLpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickChain1MixChanged = [this](float v) {
-        engine.params().kickChain1Mix.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain1Mix, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickChain1DriveMulChanged = [this](float v) {
-        engine.params().kickChain1DriveMul.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain1DriveMul, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickChain1LpHzChanged = [this](float v) {
-        engine.params().kickChain1LpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain1LpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickChain1AsymChanged = [this](float v) {
-        engine.params().kickChain1Asym.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain1Asym, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickChain1ClipModeChanged = [this](int mode) {
-        engine.params().kickChain1ClipMode.store((float)mode, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain1ClipMode, (float)mode);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickChain2MixChanged = [this](float v) {
-        engine.params().kickChain2Mix.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain2Mix, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickChain2DriveMulChanged = [this](float v) {
-        engine.params().kickChain2DriveMul.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain2DriveMul, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickChain2LpHzChanged = [this](float v) {
-        engine.params().kickChain2LpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain2LpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickChain2AsymChanged = [this](float v) {
-        engine.params().kickChain2Asym.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain2Asym, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickChain2ClipModeChanged = [this](int mode) {
-        engine.params().kickChain2ClipMode.store((float)mode, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickChain2ClipMode, (float)mode);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickTokAmountChanged = [this](float v) {
-        engine.params().kickTokAmount.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickTokAmount, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickTokHpHzChanged = [this](float v) {
-        engine.params().kickTokHpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickTokHpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickCrunchAmountChanged = [this](float v) {
-        engine.params().kickCrunchAmount.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickCrunchAmount, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickTailDecayChanged = [this](float v) {
-        engine.params().kickTailDecay.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickTailDecay, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickTailMixChanged = [this](float v) {
-        engine.params().kickTailMix.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickTailMix, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickTailFreqMulChanged = [this](float v) {
-        engine.params().kickTailFreqMul.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickTailFreqMul, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickSubMixChanged = [this](float v) {
-        engine.params().kickSubMix.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickSubMix, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickSubLpHzChanged = [this](float v) {
-        engine.params().kickSubLpHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickSubLpHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickFeedbackChanged = [this](float v) {
-        engine.params().kickFeedback.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFeedback, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     // === Kick Layers (1/2) ===
     drumControlPanel.onKickLayer1EnabledChanged = [this](float v) {
-        engine.params().kickLayer1Enabled.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Enabled, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1TypeChanged = [this](float v) {
-        engine.params().kickLayer1Type.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Type, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1FreqHzChanged = [this](float v) {
-        engine.params().kickLayer1FreqHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1FreqHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1Phase01Changed = [this](float v) {
-        engine.params().kickLayer1Phase01.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Phase01, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1DriveChanged = [this](float v) {
-        engine.params().kickLayer1Drive.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Drive, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1AttackCoeffChanged = [this](float v) {
-        engine.params().kickLayer1AttackCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1AttackCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1DecayCoeffChanged = [this](float v) {
-        engine.params().kickLayer1DecayCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1DecayCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1VolChanged = [this](float v) {
-        engine.params().kickLayer1Vol.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Vol, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickLayer2EnabledChanged = [this](float v) {
-        engine.params().kickLayer2Enabled.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Enabled, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2TypeChanged = [this](float v) {
-        engine.params().kickLayer2Type.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Type, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2FreqHzChanged = [this](float v) {
-        engine.params().kickLayer2FreqHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2FreqHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2Phase01Changed = [this](float v) {
-        engine.params().kickLayer2Phase01.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Phase01, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2DriveChanged = [this](float v) {
-        engine.params().kickLayer2Drive.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Drive, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2AttackCoeffChanged = [this](float v) {
-        engine.params().kickLayer2AttackCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2AttackCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2DecayCoeffChanged = [this](float v) {
-        engine.params().kickLayer2DecayCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2DecayCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2VolChanged = [this](float v) {
-        engine.params().kickLayer2Vol.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Vol, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     // === Kick LFO ===
     drumControlPanel.onKickLfoAmountChanged = [this](float v) {
-        engine.params().kickLfoAmount.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLfoAmount, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLfoRateHzChanged = [this](float v) {
-        engine.params().kickLfoRateHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLfoRateHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLfoShapeChanged = [this](float v) {
-        engine.params().kickLfoShape.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLfoShape, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLfoTargetChanged = [this](float v) {
-        engine.params().kickLfoTarget.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLfoTarget, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLfoPulseChanged = [this](float v) {
-        engine.params().kickLfoPulse.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLfoPulse, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     // === Kick Reverb + Quality ===
     drumControlPanel.onKickReverbAmountChanged = [this](float v) {
-        engine.params().kickReverbAmount.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickReverbAmount, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickReverbSizeChanged = [this](float v) {
-        engine.params().kickReverbSize.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickReverbSize, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickReverbToneChanged = [this](float v) {
-        engine.params().kickReverbTone.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickReverbTone, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
-    drumControlPanel.onKickOversample2xChanged = [this](float v) {
-        engine.params().kickOversample2x.store(v, std::memory_order_relaxed);
+    drumControlPanel.onKickOversampleChanged = [this](float v) {
+        engine.params().set(&drumbox_core::Params::kickOversample, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxShiftHzChanged = [this](float v) {
-        engine.params().kickFxShiftHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxShiftHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxStereoChanged = [this](float v) {
-        engine.params().kickFxStereo.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxStereo, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxDiffusionChanged = [this](float v) {
-        engine.params().kickFxDiffusion.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxDiffusion, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxCleanDirtyChanged = [this](float v) {
-        engine.params().kickFxCleanDirty.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxCleanDirty, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxToneChanged = [this](float v) {
-        engine.params().kickFxTone.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxTone, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxEnvAttackCoeffChanged = [this](float v) {
-        engine.params().kickFxEnvAttackCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxEnvAttackCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxEnvDecayCoeffChanged = [this](float v) {
-        engine.params().kickFxEnvDecayCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxEnvDecayCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxEnvVolChanged = [this](float v) {
-        engine.params().kickFxEnvVol.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxEnvVol, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickFxDisperseChanged = [this](float v) {
-        engine.params().kickFxDisperse.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxDisperse, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickFxOttAmountChanged = [this](float v) {
-        engine.params().kickFxOttAmount.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxOttAmount, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickFxInflatorChanged = [this](float v) {
-        engine.params().kickFxInflator.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxInflator, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickFxInflatorMixChanged = [this](float v) {
-        engine.params().kickFxInflatorMix.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickFxInflatorMix, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     // === Master ===
     drumControlPanel.onMasterEqLowDbChanged = [this](float v) {
-        engine.params().masterEqLowDb.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::masterEqLowDb, v);
         if (drumWavePreview)
             drumWavePreview->rerender();
     };
     drumControlPanel.onMasterEqMidDbChanged = [this](float v) {
-        engine.params().masterEqMidDb.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::masterEqMidDb, v);
         if (drumWavePreview)
             drumWavePreview->rerender();
     };
     drumControlPanel.onMasterEqHighDbChanged = [this](float v) {
-        engine.params().masterEqHighDb.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::masterEqHighDb, v);
         if (drumWavePreview)
             drumWavePreview->rerender();
     };
     drumControlPanel.onMasterClipOnChanged = [this](float v) {
-        engine.params().masterClipOn.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::masterClipOn, v);
         if (drumWavePreview)
             drumWavePreview->rerender();
     };
     drumControlPanel.onMasterClipModeChanged = [this](float v) {
-        engine.params().masterClipMode.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::masterClipMode, v);
         if (drumWavePreview)
             drumWavePreview->rerender();
     };
 
     // === Kick layers ===
     drumControlPanel.onKickLayer1EnabledChanged = [this](float v) {
-        engine.params().kickLayer1Enabled.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Enabled, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1TypeChanged = [this](float v) {
-        engine.params().kickLayer1Type.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Type, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1FreqHzChanged = [this](float v) {
-        engine.params().kickLayer1FreqHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1FreqHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1Phase01Changed = [this](float v) {
-        engine.params().kickLayer1Phase01.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Phase01, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1DriveChanged = [this](float v) {
-        engine.params().kickLayer1Drive.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Drive, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1AttackCoeffChanged = [this](float v) {
-        engine.params().kickLayer1AttackCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1AttackCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1DecayCoeffChanged = [this](float v) {
-        engine.params().kickLayer1DecayCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1DecayCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer1VolChanged = [this](float v) {
-        engine.params().kickLayer1Vol.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer1Vol, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickLayer2EnabledChanged = [this](float v) {
-        engine.params().kickLayer2Enabled.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Enabled, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2TypeChanged = [this](float v) {
-        engine.params().kickLayer2Type.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Type, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2FreqHzChanged = [this](float v) {
-        engine.params().kickLayer2FreqHz.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2FreqHz, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2Phase01Changed = [this](float v) {
-        engine.params().kickLayer2Phase01.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Phase01, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2DriveChanged = [this](float v) {
-        engine.params().kickLayer2Drive.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Drive, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2AttackCoeffChanged = [this](float v) {
-        engine.params().kickLayer2AttackCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2AttackCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2DecayCoeffChanged = [this](float v) {
-        engine.params().kickLayer2DecayCoeff.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2DecayCoeff, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
     drumControlPanel.onKickLayer2VolChanged = [this](float v) {
-        engine.params().kickLayer2Vol.store(v, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickLayer2Vol, v);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickClipModeChanged = [this](int mode) {
-        engine.params().kickClipMode.store((float)mode, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::kickClipMode, (float)mode);
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onKickPresetSelected = [this](int presetId) {
         // presetId: 1=Gabber, 2=Hardstyle, 3=Tribecore
+        // apply() ne marque que les groupes des champs modifiés
+        drumbox_core::ParamSnapshot p = engine.params().snapshot();
         if (presetId == 1)
         {
-            engine.params().kickPostHpHz.store(28.0f, std::memory_order_relaxed);
-            engine.params().kickTailMix.store(0.65f, std::memory_order_relaxed);
-            engine.params().kickTailDecay.store(0.99935f, std::memory_order_relaxed);
-            engine.params().kickTailFreqMul.store(1.0f, std::memory_order_relaxed);
-            engine.params().kickSubMix.store(0.25f, std::memory_order_relaxed);
-            engine.params().kickSubLpHz.store(160.0f, std::memory_order_relaxed);
-            engine.params().kickFeedback.store(0.18f, std::memory_order_relaxed);
-
-            engine.params().kickChain1Mix.store(0.45f, std::memory_order_relaxed);
-            engine.params().kickChain1DriveMul.store(1.30f, std::memory_order_relaxed);
-            engine.params().kickChain1LpHz.store(8500.0f, std::memory_order_relaxed);
-            engine.params().kickChain1Asym.store(0.05f, std::memory_order_relaxed);
-
-            engine.params().kickChain2Mix.store(0.55f, std::memory_order_relaxed);
-            engine.params().kickChain2DriveMul.store(2.20f, std::memory_order_relaxed);
-            engine.params().kickChain2LpHz.store(4200.0f, std::memory_order_relaxed);
-            engine.params().kickChain2Asym.store(0.35f, std::memory_order_relaxed);
-
-            engine.params().kickTokAmount.store(0.25f, std::memory_order_relaxed);
-            engine.params().kickTokHpHz.store(200.0f, std::memory_order_relaxed);
-            engine.params().kickCrunchAmount.store(0.35f, std::memory_order_relaxed);
+            p.kickPostHpHz = 28.0f;
+            p.kickTailMix = 0.65f;
+            p.kickTailDecay = 0.99935f;
+            p.kickTailFreqMul = 1.0f;
+            p.kickSubMix = 0.25f;
+            p.kickSubLpHz = 160.0f;
+            p.kickFeedback = 0.18f;
+
+            p.kickChain1Mix = 0.45f;
+            p.kickChain1DriveMul = 1.30f;
+            p.kickChain1LpHz = 8500.0f;
+            p.kickChain1Asym = 0.05f;
+
+            p.kickChain2Mix = 0.55f;
+            p.kickChain2DriveMul = 2.20f;
+            p.kickChain2LpHz = 4200.0f;
+            p.kickChain2Asym = 0.35f;
+
+            p.kickTokAmount = 0.25f;
+            p.kickTokHpHz = 200.0f;
+            p.kickCrunchAmount = 0.35f;
         }
         else if (presetId == 2)
         {
-            engine.params().kickPostHpHz.store(24.0f, std::memory_order_relaxed);
-            engine.params().kickTailMix.store(0.55f, std::memory_order_relaxed);
-            engine.params().kickTailDecay.store(0.99925f, std::memory_order_relaxed);
-            engine.params().kickTailFreqMul.store(1.0f, std::memory_order_relaxed);
-            engine.params().kickSubMix.store(0.32f, std::memory_order_relaxed);
-            engine.params().kickSubLpHz.store(180.0f, std::memory_order_relaxed);
-            engine.params().kickFeedback.store(0.12f, std::memory_order_relaxed);
-
-            engine.params().kickChain1Mix.store(0.70f, std::memory_order_relaxed);
-            engine.params().kickChain1DriveMul.store(1.20f, std::memory_order_relaxed);
-            engine.params().kickChain1LpHz.store(9000.0f, std::memory_order_relaxed);
-            engine.params().kickChain1Asym.store(0.05f, std::memory_order_relaxed);
-
-            engine.params().kickChain2Mix.store(0.30f, std::memory_order_relaxed);
-            engine.params().kickChain2DriveMul.store(1.60f, std::memory_order_relaxed);
-            engine.params().kickChain2LpHz.store(5200.0f, std::memory_order_relaxed);
-            engine.params().kickChain2Asym.store(0.20f, std::memory_order_relaxed);
-
-            engine.params().kickTokAmount.store(0.18f, std::memory_order_relaxed);
-            engine.params().kickTokHpHz.store(160.0f, std::memory_order_relaxed);
-            engine.params().kickCrunchAmount.store(0.18f, std::memory_order_relaxed);
+            p.kickPostHpHz = 24.0f;
+            p.kickTailMix = 0.55f;
+            p.kickTailDecay = 0.99925f;
+            p.kickTailFreqMul = 1.0f;
+            p.kickSubMix = 0.32f;
+            p.kickSubLpHz = 180.0f;
+            p.kickFeedback = 0.12f;
+
+            p.kickChain1Mix = 0.70f;
+            p.kickChain1DriveMul = 1.20f;
+            p.kickChain1LpHz = 9000.0f;
+            p.kickChain1Asym = 0.05f;
+
+            p.kickChain2Mix = 0.30f;
+            p.kickChain2DriveMul = 1.60f;
+            p.kickChain2LpHz = 5200.0f;
+            p.kickChain2Asym = 0.20f;
+
+            p.kickTokAmount = 0.18f;
+            p.kickTokHpHz = 160.0f;
+            p.kickCrunchAmount = 0.18f;
         }
         else
         {
-            engine.params().kickPostHpHz.store(35.0f, std::memory_order_relaxed);
-            engine.params().kickTailMix.store(0.40f, std::memory_order_relaxed);
-            engine.params().kickTailDecay.store(0.99910f, std::memory_order_relaxed);
-            engine.params().kickTailFreqMul.store(1.0f, std::memory_order_relaxed);
-            engine.params().kickSubMix.store(0.38f, std::memory_order_relaxed);
-            engine.params().kickSubLpHz.store(200.0f, std::memory_order_relaxed);
-            engine.params().kickFeedback.store(0.06f, std::memory_order_relaxed);
-
-            engine.params().kickChain1Mix.store(0.75f, std::memory_order_relaxed);
-            engine.params().kickChain1DriveMul.store(1.05f, std::memory_order_relaxed);
-            engine.params().kickChain1LpHz.store(10000.0f, std::memory_order_relaxed);
-            engine.params().kickChain1Asym.store(-0.05f, std::memory_order_relaxed);
-
-            engine.params().kickChain2Mix.store(0.25f, std::memory_order_relaxed);
-            engine.params().kickChain2DriveMul.store(1.30f, std::memory_order_relaxed);
-            engine.params().kickChain2LpHz.store(6500.0f, std::memory_order_relaxed);
-            engine.params().kickChain2Asym.store(0.10f, std::memory_order_relaxed);
-
-            engine.params().kickTokAmount.store(0.35f, std::memory_order_relaxed);
-            engine.params().kickTokHpHz.store(260.0f, std::memory_order_relaxed);
-            engine.params().kickCrunchAmount.store(0.10f, std::memory_order_relaxed);
+            p.kickPostHpHz = 35.0f;
+            p.kickTailMix = 0.40f;
+            p.kickTailDecay = 0.99910f;
+            p.kickTailFreqMul = 1.0f;
+            p.kickSubMix = 0.38f;
+            p.kickSubLpHz = 200.0f;
+            p.kickFeedback = 0.06f;
+
+            p.kickChain1Mix = 0.75f;
+            p.kickChain1DriveMul = 1.05f;
+            p.kickChain1LpHz = 10000.0f;
+            p.kickChain1Asym = -0.05f;
+
+            p.kickChain2Mix = 0.25f;
+            p.kickChain2DriveMul = 1.30f;
+            p.kickChain2LpHz = 6500.0f;
+            p.kickChain2Asym = 0.10f;
+
+            p.kickTokAmount = 0.35f;
+            p.kickTokHpHz = 260.0f;
+            p.kickCrunchAmount = 0.10f;
         }
 
+        engine.params().apply(p);
+
         if (drumWavePreview && selectedDrum == 0)
             drumWavePreview->rerender();
     };
 
     drumControlPanel.onSnareToneChanged = [this](float value) {
-        engine.params().snareToneFreq.store(value, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::snareToneFreq, value);
         if (drumWavePreview && selectedDrum == 1)
             drumWavePreview->rerender();
     };
     
     drumControlPanel.onSnareNoiseMixChanged = [this](float value) {
-        engine.params().snareNoiseMix.store(value, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::snareNoiseMix, value);
         if (drumWavePreview && selectedDrum == 1)
             drumWavePreview->rerender();
     };
     
     drumControlPanel.onHatCutoffChanged = [this](float value) {
-        engine.params().hatCutoff.store(value, std::memory_order_relaxed);
+        engine.params().set(&drumbox_core::Params::hatCutoff, value);
         if (drumWavePreview && selectedDrum == 2)
             drumWavePreview->rerender();
     };
@@ -731,120 +740,33 @@ MainComponent::MainComponent()
     drumWavePreview->setDurationMs(400);
     
     // Configure le render pour le drum sélectionné
-    drumWavePreview->setRenderFn([this](juce::AudioBuffer<float>& out, int sr, int durMs) {
+    // (thread de rendu du preview : ne lit que les atomics de engine.params() et selectedDrum)
+    auto* preview = drumWavePreview.get();
+    drumWavePreview->setRenderFn([this, preview](juce::AudioBuffer<float>& out, int sr, int durMs) {
         // Créer un engine temporaire pour le rendu offline
+        constexpr int kChunk = 1024;
         drumbox_core::Engine tempEngine;
-        tempEngine.prepare((double)sr, out.getNumSamples());
-        
-        // Copier les paramètres actuels (manuellement car std::atomic n'est pas copiable)
-        auto& src = engine.params();
-        auto& dst = tempEngine.params();
+        tempEngine.prepare((double)sr, kChunk);
         
-        dst.masterGain.store(src.masterGain.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickDecay.store(src.kickDecay.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickPitchDecay.store(src.kickPitchDecay.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickDriveDecay.store(src.kickDriveDecay.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickAttackFreq.store(src.kickAttackFreq.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickBaseFreq.store(src.kickBaseFreq.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickDriveAmount.store(src.kickDriveAmount.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickClickGain.store(src.kickClickGain.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickPreHpHz.store(src.kickPreHpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickPostGain.store(src.kickPostGain.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickPostHpHz.store(src.kickPostHpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickPostLpHz.store(src.kickPostLpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickClipMode.store(src.kickClipMode.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickTailDecay.store(src.kickTailDecay.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickTailMix.store(src.kickTailMix.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickTailFreqMul.store(src.kickTailFreqMul.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickSubMix.store(src.kickSubMix.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickSubLpHz.store(src.kickSubLpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFeedback.store(src.kickFeedback.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickChain1Mix.store(src.kickChain1Mix.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain1DriveMul.store(src.kickChain1DriveMul.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain1LpHz.store(src.kickChain1LpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain1Asym.store(src.kickChain1Asym.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain1ClipMode.store(src.kickChain1ClipMode.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickChain2Mix.store(src.kickChain2Mix.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain2DriveMul.store(src.kickChain2DriveMul.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain2LpHz.store(src.kickChain2LpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain2Asym.store(src.kickChain2Asym.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickChain2ClipMode.store(src.kickChain2ClipMode.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickTokAmount.store(src.kickTokAmount.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickTokHpHz.store(src.kickTokHpHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickCrunchAmount.store(src.kickCrunchAmount.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        // Kick layers
-        dst.kickLayer1Enabled.store(src.kickLayer1Enabled.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1Type.store(src.kickLayer1Type.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1FreqHz.store(src.kickLayer1FreqHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1Phase01.store(src.kickLayer1Phase01.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1Drive.store(src.kickLayer1Drive.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1AttackCoeff.store(src.kickLayer1AttackCoeff.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1DecayCoeff.store(src.kickLayer1DecayCoeff.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer1Vol.store(src.kickLayer1Vol.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickLayer2Enabled.store(src.kickLayer2Enabled.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2Type.store(src.kickLayer2Type.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2FreqHz.store(src.kickLayer2FreqHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2Phase01.store(src.kickLayer2Phase01.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2Drive.store(src.kickLayer2Drive.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2AttackCoeff.store(src.kickLayer2AttackCoeff.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2DecayCoeff.store(src.kickLayer2DecayCoeff.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLayer2Vol.store(src.kickLayer2Vol.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickLfoAmount.store(src.kickLfoAmount.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLfoRateHz.store(src.kickLfoRateHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLfoShape.store(src.kickLfoShape.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLfoTarget.store(src.kickLfoTarget.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickLfoPulse.store(src.kickLfoPulse.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        // Kick Reverb + quality
-        dst.kickReverbAmount.store(src.kickReverbAmount.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickReverbSize.store(src.kickReverbSize.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickReverbTone.store(src.kickReverbTone.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickOversample2x.store(src.kickOversample2x.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.kickFxDisperse.store(src.kickFxDisperse.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxInflator.store(src.kickFxInflator.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxInflatorMix.store(src.kickFxInflatorMix.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxOttAmount.store(src.kickFxOttAmount.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxShiftHz.store(src.kickFxShiftHz.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxStereo.store(src.kickFxStereo.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxDiffusion.store(src.kickFxDiffusion.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxCleanDirty.store(src.kickFxCleanDirty.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxTone.store(src.kickFxTone.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxEnvAttackCoeff.store(src.kickFxEnvAttackCoeff.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxEnvDecayCoeff.store(src.kickFxEnvDecayCoeff.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.kickFxEnvVol.store(src.kickFxEnvVol.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        // Master
-        dst.masterEqLowDb.store(src.masterEqLowDb.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.masterEqMidDb.store(src.masterEqMidDb.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.masterEqHighDb.store(src.masterEqHighDb.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.masterClipOn.store(src.masterClipOn.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.masterClipMode.store(src.masterClipMode.load(std::memory_order_relaxed), std::memory_order_relaxed);
-
-        dst.snareDecay.store(src.snareDecay.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.snareToneFreq.store(src.snareToneFreq.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.snareNoiseMix.store(src.snareNoiseMix.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.hatDecay.store(src.hatDecay.load(std::memory_order_relaxed), std::memory_order_relaxed);
-        dst.hatCutoff.store(src.hatCutoff.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        // Copie des paramètres actuels (tous les champs de la table, voir ParamTable.h)
+        tempEngine.params().apply(engine.params().snapshot());
         
         // Activer le step 0 pour le drum sélectionné
-        tempEngine.setStep(selectedDrum, 0, true, 1.0f);
+        tempEngine.setStep(selectedDrum.load(), 0, true, 1.0f);
         tempEngine.setPlaying(true);
         
-        // Render le buffer
-        std::vector<float> interleaved((size_t)out.getNumSamples() * 2u);
-        tempEngine.process(interleaved.data(), out.getNumSamples(), 2);
-        
-        // Copie canal gauche vers mono
-        for (int i = 0; i < out.getNumSamples(); ++i)
-            out.setSample(0, i, interleaved[i * 2]);
+        // Render par tranches : abandon dès qu'une demande plus récente arrive
+        const int total = out.getNumSamples();
+        std::vector<float> interleaved((size_t)kChunk * 2u);
+        for (int pos = 0; pos < total && !preview->renderCancelled(); pos += kChunk)
+        {
+            const int n = std::min(kChunk, total - pos);
+            tempEngine.process(interleaved.data(), n, 2);
+
+            // Copie canal gauche vers mono
+            for (int i = 0; i < n; ++i)
+                out.setSample(0, pos + i, interleaved[(size_t)i * 2]);
+        }
     });
     
     drumWavePreview->rerender();
@@ -856,6 +778,8 @@ MainComponent::MainComponent()
 
 MainComponent::~MainComponent()
 {
+    // arrête le thread de rendu du preview avant que engine ne soit détruit
+    drumWavePreview.reset();
     shutdownAudio();
 }
 
@@ -872,9 +796,7 @@ void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRat
     updatePlayheadOutline();
 
     // masterSlider est en dB côté UI
-    engine.params().masterGain.store((float)std::pow(10.0, masterSlider.getValue() / 20.0), std::memory_order_relaxed);
-
-    interleavedTmp.resize((size_t)samplesPerBlockExpected * 2);
+    engine.params().set(&drumbox_core::Params::masterGain, (float)std::pow(10.0, masterSlider.getValue() / 20.0));
 
     // sync UI pattern (le core a un pattern demo)
     refreshGridFromPattern();
@@ -884,45 +806,25 @@ void MainComponent::releaseResources() {}
 
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& info)
 {
-    info.clearActiveBufferRegion();
-
-    Command cmd;
-    while (queue.pop(cmd))
-    {
-        switch (cmd.type)
-        {
-            case Command::ToggleStep:
-                engine.setStep(cmd.lane, cmd.step, cmd.on, 1.0f);
-                break;
-            case Command::SetBpm:
-                engine.setBpm(cmd.f);
-                break;
-            case Command::SetPlaying:
-                engine.setPlaying(cmd.on);
-                break;
-        }
-    }
-
+    // Les commandes UI (engine.pushCommand) sont appliquées au début de processPlanar.
     auto* buffer = info.buffer;
-    const int ch = buffer->getNumChannels();
     const int n  = info.numSamples;
 
-    if ((int)interleavedTmp.size() < n * ch)
-        interleavedTmp.resize((size_t)n * (size_t)ch);
+    // rendu planar directement dans les canaux JUCE (pas de buffer intermédiaire)
+    float* channels[kMaxOutputChannels];
+    const int ch = juce::jmin(buffer->getNumChannels(), kMaxOutputChannels);
+    for (int c = 0; c < ch; ++c)
+        channels[c] = buffer->getWritePointer(c, info.startSample);
 
-    engine.process(interleavedTmp.data(), n, ch);
+    engine.processPlanar(channels, ch, n);
 
-    for (int c = 0; c < ch; ++c)
-    {
-        float* dst = buffer->getWritePointer(c, info.startSample);
-        for (int i = 0; i < n; ++i)
-            dst[i] = interleavedTmp[(size_t)i * (size_t)ch + (size_t)c];
-    }
+    for (int c = ch; c < buffer->getNumChannels(); ++c)
+        buffer->clear(c, info.startSample, n);
 }
 
 void MainComponent::pushToggle(int lane, int step, bool on)
 {
-    queue.push(Command::toggleStep(lane, step, on));
+    engine.pushCommand(drumbox_core::Command::setStep(lane, step, on));
 }
 
 void MainComponent::refreshGridFromPattern()
@@ -944,6 +846,17 @@ void MainComponent::updatePlayheadOutline()
 void MainComponent::timerCallback()
 {
     updatePlayheadOutline();
+
+    if (++cpuStatsTicks >= DrumBoxConstants::Audio::cpuStatsInterval)
+    {
+        cpuStatsTicks = 0;
+        const auto stats = engine.cpuMeter().read();
+        cpuLabel.setText(CpuStatsText::summary(stats), juce::dontSendNotification);
+        cpuLabel.setTooltip(CpuStatsText::details(stats));
+        cpuLabel.setColour(juce::Label::textColourId,
+                           stats.xruns > 0 ? juce::Colours::orangered : juce::Colours::lightgrey);
+    }
+
     repaint();
 }
 
@@ -996,6 +909,9 @@ void MainComponent::resized()
     masterLabel.setBounds(masterArea.removeFromLeft(60).reduced(4, 12));
     masterSlider.setBounds(masterArea.reduced(4, 12));
 
+    // CPU (entre BPM et Master)
+    cpuLabel.setBounds(topBar.reduced(4, 12));
+
     // === MILIEU : Contrôles des instruments (un seul affiché) ===
     auto drumControls = area.removeFromTop(drumControlHeight);
     
@@ -8,8 +8,9 @@
 #include "components/drumControlPanel/DrumControlPanel.h"
 #include "components/drumSelector/DrumSelector.h"
 #include "components/DrumWavePreviewComponent/DrumWavePreviewComponent.h"
-#include "utils/Command.h"
+#include "components/transportBar/TransportBar.h"
 #include "utils/Constants.h"
+#include "utils/CpuStatsText.h"
 #include <array>
 #include <vector>
 
@@ -41,11 +42,17 @@ private:
     juce::Slider masterSlider;
     juce::Label masterLabel;
 
+    // Charge CPU du moteur (Engine::cpuMeter), rafraîchie par le timer UI ;
+    // tooltip = étages + histogramme (TooltipWindow nécessaire pour l'afficher)
+    juce::Label cpuLabel;
+    int cpuStatsTicks = 0;
+    juce::TooltipWindow tooltipWindow { this };
+
     // Sélecteur de drum
     juce::TextButton kickSelectButton { "KICK" };
     juce::TextButton snareSelectButton { "SNARE" };
     juce::TextButton hatSelectButton { "HAT" };
-    int selectedDrum = 0; // 0=Kick, 1=Snare, 2=Hat
+    std::atomic<int> selectedDrum{0}; // 0=Kick, 1=Snare, 2=Hat (lu par le rendu du preview)
 
     // Anciens contrôles - commentés
     /*
@@ -70,9 +77,9 @@ private:
 
     // Core
     drumbox_core::Engine engine;
-    SpscQueue<DrumBoxConstants::Audio::commandQueueSize> queue;
 
-    std::vector<float> interleavedTmp;
+    // canaux de sortie rendus par le moteur (les suivants sont mis à zéro)
+    static constexpr int kMaxOutputChannels = 16;
 
     std::atomic<bool> playing{true};
 
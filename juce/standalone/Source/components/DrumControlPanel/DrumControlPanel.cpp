@@ -337,17 +337,19 @@ DrumControlPanel::DrumControlPanel()
 
     // Oversampling (Kick)
     setupSlider(kickPostGroup, kickOversampleSlider, kickOversampleLabel, "OS x");
-    kickOversampleSlider.setRange(1.0, 2.0, 1.0);
-    kickOversampleSlider.setValue(1.0, juce::dontSendNotification);
+    // valeur = qualité (0..3), affichée en facteur 1x/2x/4x/8x
+    kickOversampleSlider.setRange(0.0, 3.0, 1.0);
+    kickOversampleSlider.setValue(0.0, juce::dontSendNotification);
     kickOversampleSlider.textFromValueFunction = [](double v) {
-        return juce::String((int)std::round(v)) + "x";
+        return juce::String(1 << juce::jlimit(0, 3, (int)std::round(v))) + "x";
     };
     kickOversampleSlider.valueFromTextFunction = [](const juce::String& s) {
-        return (double)s.retainCharacters("0123456789").getIntValue();
+        const int factor = s.retainCharacters("0123456789").getIntValue();
+        return (factor >= 8) ? 3.0 : (factor >= 4) ? 2.0 : (factor >= 2) ? 1.0 : 0.0;
     };
     kickOversampleSlider.onValueChange = [this]() {
-        if (onKickOversample2xChanged)
-            onKickOversample2xChanged(kickOversampleSlider.getValue() >= 2.0 ? 1.0f : 0.0f);
+        if (onKickOversampleChanged)
+            onKickOversampleChanged((float)kickOversampleSlider.getValue());
     };
 
     // === Chain 1 ===
@@ -150,7 +150,7 @@ public:
     std::function<void(float value)> onKickReverbAmountChanged; // 0..1
     std::function<void(float value)> onKickReverbSizeChanged;   // 0..1
     std::function<void(float value)> onKickReverbToneChanged;   // 0..1
-    std::function<void(float value)> onKickOversample2xChanged; // 0/1
+    std::function<void(float value)> onKickOversampleChanged; // 0=off, 1=2x, 2=4x, 3=8x
 
     // Kick FX
     std::function<void(float value)> onKickFxShiftHzChanged;        // Hz
@@ -77,16 +77,26 @@ DrumWavePreviewComponent::DrumWavePreviewComponent(juce::AudioDeviceManager& dm)
     deviceManager.addAudioCallback(&player);
 
     // buffer par défaut
-    mono.setSize(1, (int)std::round(sampleRate * (durationMs / 1000.0)));
-    mono.clear();
-    computeStats();
-    
-    // Timer pour mettre à jour la position de lecture
+    auto r = std::make_shared<Render>();
+    r->sampleRate = sampleRate;
+    r->durationMs = durationMs;
+    r->mono.setSize(1, (int)std::round(sampleRate * (durationMs / 1000.0)));
+    r->mono.clear();
+    analyze(*r);
+    current = std::move(r);
+
+    renderThread.startThread();
+
+    // Timer : position de lecture + récupération des rendus terminés
     startTimerHz(30);
 }
 
 DrumWavePreviewComponent::~DrumWavePreviewComponent()
 {
+    renderThread.signalThreadShouldExit();
+    renderThread.notify();
+    renderThread.stopThread(2000);
+
     stopTimer();
     stopPlayback();
     deviceManager.removeAudioCallback(&player);
@@ -144,45 +154,96 @@ void DrumWavePreviewComponent::setDurationMs(int ms)
 
 void DrumWavePreviewComponent::rerender()
 {
-    const int N = (int)std::round(sampleRate * (durationMs / 1000.0));
-    mono.setSize(1, std::max(1, N));
-    mono.clear();
+    {
+        const juce::ScopedLock sl(jobLock);
+        pendingJob.id = latestJobId.load(std::memory_order_relaxed) + 1;
+        pendingJob.sampleRate = sampleRate;
+        pendingJob.durationMs = durationMs;
+        pendingJob.fn = renderFn;
+        hasPendingJob = true;
+        latestJobId.store(pendingJob.id, std::memory_order_release);
+    }
+    renderThread.notify();
+}
 
-    if (renderFn)
-        renderFn(mono, sampleRate, durationMs);
+bool DrumWavePreviewComponent::renderCancelled() const
+{
+    return renderThread.threadShouldExit()
+        || latestJobId.load(std::memory_order_acquire) != activeJobId.load(std::memory_order_relaxed);
+}
 
-    computeStats();
-    extractEnvelope();
-    analyzeSignal();
-    repaint();
+void DrumWavePreviewComponent::RenderThread::run()
+{
+    while (!threadShouldExit())
+    {
+        Job job;
+        bool got = false;
+        {
+            const juce::ScopedLock sl(owner.jobLock);
+            if (owner.hasPendingJob)
+            {
+                job = std::move(owner.pendingJob);
+                owner.hasPendingJob = false;
+                got = true;
+            }
+        }
+
+        if (!got)
+        {
+            wait(-1);
+            continue;
+        }
+
+        owner.renderJob(job);
+    }
 }
 
-void DrumWavePreviewComponent::computeStats()
+// Thread de rendu
+void DrumWavePreviewComponent::renderJob(const Job& job)
 {
-    peak = 0.0f;
-    double sumSq = 0.0;
+    activeJobId.store(job.id, std::memory_order_relaxed);
+
+    auto r = std::make_shared<Render>();
+    r->sampleRate = job.sampleRate;
+    r->durationMs = job.durationMs;
+
+    const int N = (int)std::round(job.sampleRate * (job.durationMs / 1000.0));
+    r->mono.setSize(1, std::max(1, N));
+    r->mono.clear();
 
-    const int n = mono.getNumSamples();
-    const float* x = mono.getReadPointer(0);
+    if (job.fn)
+        job.fn(r->mono, job.sampleRate, job.durationMs);
 
-    for (int i = 0; i < n; ++i)
+    // une demande plus récente attend : ce résultat est déjà périmé
+    if (renderCancelled())
+        return;
+
+    analyze(*r);
+
+    if (renderCancelled())
+        return;
+
+    publish(std::move(r));
+}
+
+void DrumWavePreviewComponent::publish(std::shared_ptr<const Render> r)
+{
     {
-        peak = std::max(peak, std::abs(x[i]));
-        sumSq += (double)x[i] * (double)x[i];
+        const juce::SpinLock::ScopedLockType sl(resultLock);
+        pendingResult = std::move(r);
     }
-
-    rms = (n > 0) ? (float)std::sqrt(sumSq / (double)n) : 0.0f;
+    resultReady.store(true, std::memory_order_release);
 }
 
 void DrumWavePreviewComponent::onPlayClicked()
 {
-    if (mono.getNumSamples() <= 0)
+    if (current->mono.getNumSamples() <= 0)
         return;
 
     stopPlayback();
 
     // Recharge le oneshot (et reset position)
-    oneShot.setBuffer(mono, (double)sampleRate);
+    oneShot.setBuffer(current->mono, (double)current->sampleRate);
 
     transport.setPosition(0.0);
     transport.start();
@@ -208,110 +269,217 @@ void DrumWavePreviewComponent::updatePlaybackPosition()
     }
 }
 
-void DrumWavePreviewComponent::extractEnvelope()
+namespace
 {
-    const int n = mono.getNumSamples();
-    if (n == 0) return;
-    
-    const float* x = mono.getReadPointer(0);
-    
-    // Extraction d'enveloppe par fenêtre glissante
-    const int windowSize = std::max(1, (int)(sampleRate * 0.005)); // 5ms
-    envelope.clear();
-    envelope.reserve(n / windowSize + 1);
-    
-    for (int i = 0; i < n; i += windowSize)
+    // Pitch : autocorrélation sur le signal décimé (fondamentale d'un kick < 1 kHz)
+    constexpr int   kPitchDecim    = 4;
+    constexpr float kPitchMinHz    = 25.0f;
+    constexpr float kPitchMaxHz    = 1000.0f;
+    constexpr float kPitchSkipMs   = 10.0f; // après l'attaque : laisse passer le sweep de pitch
+    constexpr float kPitchWindowMs = 80.0f;
+
+    // Temps (ms) où l'enveloppe passe sous thr après la fenêtre from ;
+    // interpolé entre les centres des fenêtres, fallbackMs si jamais atteint.
+    float crossingMs(const std::vector<float>& env, int from, float thr, float windowMs, float fallbackMs)
     {
-        float maxAbs = 0.0f;
-        const int end = std::min(n, i + windowSize);
-        for (int j = i; j < end; ++j)
-            maxAbs = std::max(maxAbs, std::abs(x[j]));
-        envelope.push_back(maxAbs);
+        for (int w = from + 1; w < (int)env.size(); ++w)
+        {
+            if (env[(size_t)w] <= thr)
+            {
+                const float a = env[(size_t)w - 1];
+                const float b = env[(size_t)w];
+                const float frac = (a > b) ? (a - thr) / (a - b) : 0.0f;
+                return ((float)(w - 1) + frac + 0.5f) * windowMs;
+            }
+        }
+        return fallbackMs;
     }
 }
 
-void DrumWavePreviewComponent::analyzeSignal()
+// Une seule lecture du buffer, par fenêtres de 5 ms (multiple de kPitchDecim) :
+// max |x| (enveloppe), somme des carrés et signal décimé, sur 4 voies indépendantes
+// (vectorisable sans fast-math). Tout le reste travaille sur l'enveloppe
+// (~200 points par seconde) ou sur le signal décimé.
+void DrumWavePreviewComponent::analyze(Render& r)
 {
-    const int n = mono.getNumSamples();
-    if (n == 0) return;
-    
-    const float* x = mono.getReadPointer(0);
-    const float sampleDurationMs = 1000.0f / (float)sampleRate;
-    
-    // 1. Attack Time (temps pour atteindre le pic)
-    attackTimeMs = 0.0f;
-    for (int i = 0; i < n; ++i)
+    // queues de snare/hat : valeurs dénormales dans l'autocorrélation sinon
+    juce::ScopedNoDenormals noDenormals;
+
+    const int n = r.mono.getNumSamples();
+    const float* x = r.mono.getReadPointer(0);
+    const float msPerSample = 1000.0f / (float)r.sampleRate;
+
+    r.peak = 0.0f;
+    r.rms = 0.0f;
+    r.envelope.clear();
+    r.attackTimeMs = 0.0f;
+    r.decay6dBMs = r.decay20dBMs = r.decay40dBMs = (float)r.durationMs;
+    r.effectiveDurationMs = 0.0f;
+    r.dominantFreqHz = 0.0f;
+    if (n <= 0)
+        return;
+
+    const int windowSize = std::max(kPitchDecim, (int)(r.sampleRate * 0.005) / kPitchDecim * kPitchDecim);
+    const int numWindows = (n + windowSize - 1) / windowSize;
+    const float windowMs = (float)windowSize * msPerSample;
+
+    r.envelope.resize((size_t)numWindows);
+    std::vector<float> dec((size_t)(n / kPitchDecim));
+
+    double sumSq = 0.0;
+    for (int w = 0; w < numWindows; ++w)
     {
-        if (std::abs(x[i]) >= peak * 0.9f)
+        const int i0 = w * windowSize;
+        const int i1 = std::min(n, i0 + windowSize);
+
+        float m[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float sq[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        int i = i0;
+        for (; i + 4 <= i1; i += 4)
         {
-            attackTimeMs = (float)i * sampleDurationMs;
-            break;
+            for (int k = 0; k < 4; ++k)
+            {
+                m[k] = std::max(m[k], std::abs(x[i + k]));
+                sq[k] += x[i + k] * x[i + k];
+            }
+            dec[(size_t)(i / kPitchDecim)] = 0.25f * (x[i] + x[i + 1] + x[i + 2] + x[i + 3]);
         }
+        for (; i < i1; ++i)
+        {
+            m[0] = std::max(m[0], std::abs(x[i]));
+            sq[0] += x[i] * x[i];
+        }
+
+        const float wMax = std::max(std::max(m[0], m[1]), std::max(m[2], m[3]));
+        r.envelope[(size_t)w] = wMax;
+        r.peak = std::max(r.peak, wMax);
+        sumSq += (double)((sq[0] + sq[1]) + (sq[2] + sq[3]));
     }
-    
-    // 2. Decay -6dB (peak/2 en linéaire)
-    decay6dBMs = (float)durationMs;
-    const float threshold6dB = peak * 0.5f;
-    for (int i = 0; i < n; ++i)
+
+    r.rms = (float)std::sqrt(sumSq / (double)n);
+    if (r.peak <= 0.0f)
+        return;
+
+    // 1. Attack : premier sample >= 90% du pic (recherche fine dans la fenêtre trouvée)
+    int peakWindow = 0;
+    int attackSample = 0;
+    for (int w = 0; w < numWindows; ++w)
     {
-        if (std::abs(x[i]) >= peak * 0.9f)
+        if (r.envelope[(size_t)w] >= r.peak * 0.9f)
         {
-            // Cherche après le pic
-            for (int j = i; j < n; ++j)
-            {
-                if (std::abs(x[j]) <= threshold6dB)
-                {
-                    decay6dBMs = (float)j * sampleDurationMs;
-                    break;
-                }
-            }
+            attackSample = w * windowSize;
+            while (std::abs(x[attackSample]) < r.peak * 0.9f)
+                ++attackSample;
             break;
         }
     }
-    
-    // 3. Decay -20dB (peak/10 en linéaire)
-    decay20dBMs = (float)durationMs;
-    const float threshold20dB = peak * 0.1f;
-    for (int i = 0; i < n; ++i)
+    for (int w = 0; w < numWindows; ++w)
     {
-        if (std::abs(x[i]) >= peak * 0.9f)
+        if (r.envelope[(size_t)w] >= r.peak)
         {
-            for (int j = i; j < n; ++j)
-            {
-                if (std::abs(x[j]) <= threshold20dB)
-                {
-                    decay20dBMs = (float)j * sampleDurationMs;
-                    break;
-                }
-            }
+            peakWindow = w;
             break;
         }
     }
-    
-    // 4. Durée effective (signal > -40dB)
-    effectiveDurationMs = 0.0f;
-    const float thresholdEffective = peak * 0.01f;
-    for (int i = n - 1; i >= 0; --i)
+    r.attackTimeMs = (float)attackSample * msPerSample;
+
+    // 2. Decay -6 / -20 / -40 dB : l'enveloppe (pas le signal, qui passe par zéro
+    //    à chaque période) descend sous le seuil après le pic
+    r.decay6dBMs  = crossingMs(r.envelope, peakWindow, r.peak * 0.5f,  windowMs, (float)r.durationMs);
+    r.decay20dBMs = crossingMs(r.envelope, peakWindow, r.peak * 0.1f,  windowMs, (float)r.durationMs);
+    r.decay40dBMs = crossingMs(r.envelope, peakWindow, r.peak * 0.01f, windowMs, (float)r.durationMs);
+
+    // 3. Durée effective : dernier sample > -40 dB
+    const float thresholdEffective = r.peak * 0.01f;
+    for (int w = numWindows - 1; w >= 0; --w)
     {
-        if (std::abs(x[i]) > thresholdEffective)
+        if (r.envelope[(size_t)w] > thresholdEffective)
         {
-            effectiveDurationMs = (float)i * sampleDurationMs;
+            int i = std::min(n, (w + 1) * windowSize) - 1;
+            while (std::abs(x[i]) <= thresholdEffective)
+                --i;
+            r.effectiveDurationMs = (float)i * msPerSample;
             break;
         }
     }
-    
-    // 5. Fréquence dominante (zero-crossing simpliste)
-    int zeroCrossings = 0;
-    for (int i = 1; i < std::min(n, (int)(sampleRate * 0.1)); ++i)
+
+    // 4. Pitch : corps du kick, juste après l'attaque
+    const int begin = (attackSample + (int)(kPitchSkipMs / msPerSample)) / kPitchDecim;
+    r.dominantFreqHz = estimatePitchHz(dec, begin, (float)r.sampleRate / (float)kPitchDecim);
+}
+
+// Autocorrélation normalisée sur kPitchWindowMs ; plus petit retard dont le pic
+// atteint 90% du meilleur (évite l'octave en dessous), affiné par parabole.
+// 0 si pas de périodicité nette (bruit, hat) ou signal trop court.
+float DrumWavePreviewComponent::estimatePitchHz(const std::vector<float>& dec, int begin, float decSr)
+{
+    const int size = (int)dec.size();
+    const int minLag = std::max(2, (int)(decSr / kPitchMaxHz));
+    const int maxLag = (int)(decSr / kPitchMinHz);
+    int len = (int)(decSr * kPitchWindowMs / 1000.0f);
+    len = std::min(len, size - begin - maxLag - 1);
+    if (begin < 0 || len < maxLag)
+        return 0.0f;
+
+    const float* a = dec.data() + begin;
+
+    auto dot = [len](const float* p, const float* q) {
+        float s[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        int i = 0;
+        for (; i + 4 <= len; i += 4)
+            for (int k = 0; k < 4; ++k)
+                s[k] += p[i + k] * q[i + k];
+        for (; i < len; ++i)
+            s[0] += p[i] * q[i];
+        return (s[0] + s[1]) + (s[2] + s[3]);
+    };
+
+    const float e0 = dot(a, a);
+    if (e0 <= 1.0e-12f)
+        return 0.0f;
+
+    // énergie de la fenêtre décalée, glissante
+    float ek = dot(a + minLag, a + minLag);
+
+    std::vector<float> acf((size_t)(maxLag + 2), 0.0f);
+    float best = 0.0f;
+    for (int k = minLag; k <= maxLag + 1; ++k)
+    {
+        acf[(size_t)k] = (ek > 1.0e-12f) ? dot(a, a + k) / std::sqrt(e0 * ek) : 0.0f;
+        if (k <= maxLag)
+            best = std::max(best, acf[(size_t)k]);
+        if (k <= maxLag)
+            ek += a[k + len] * a[k + len] - a[k] * a[k];
+    }
+
+    if (best < 0.3f)
+        return 0.0f;
+
+    for (int k = minLag + 1; k <= maxLag; ++k)
     {
-        if ((x[i-1] >= 0.0f && x[i] < 0.0f) || (x[i-1] < 0.0f && x[i] >= 0.0f))
-            zeroCrossings++;
+        const float y0 = acf[(size_t)k - 1], y1 = acf[(size_t)k], y2 = acf[(size_t)k + 1];
+        if (y1 >= 0.9f * best && y1 >= y0 && y1 >= y2)
+        {
+            const float den = y0 - 2.0f * y1 + y2;
+            const float off = (den < 0.0f) ? 0.5f * (y0 - y2) / den : 0.0f;
+            return decSr / ((float)k + off);
+        }
     }
-    dominantFreqHz = (float)zeroCrossings * 5.0f; // sur 100ms
+    return 0.0f;
 }
 
 void DrumWavePreviewComponent::timerCallback()
 {
+    // rendu terminé : remplace celui affiché
+    if (resultReady.exchange(false, std::memory_order_acquire))
+    {
+        {
+            const juce::SpinLock::ScopedLockType sl(resultLock);
+            current = std::move(pendingResult);
+        }
+        repaint();
+    }
+
     updatePlaybackPosition();
 }
 
@@ -330,6 +498,8 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
 {
     g.fillAll(theme.bg);
 
+    const Render& res = *current;
+
     auto r = getLocalBounds().reduced(8);
     r.removeFromTop(22 + 6);
 
@@ -345,8 +515,8 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
     
     // Zoom vertical automatique (normalisation si signal faible)
     float displayScale = 1.0f;
-    if (autoNormalize && peak > 0.0f && peak < 0.3f)
-        displayScale = 0.3f / peak;
+    if (autoNormalize && res.peak > 0.0f && res.peak < 0.3f)
+        displayScale = 0.3f / res.peak;
 
     // grille: midline
     g.setColour(theme.grid);
@@ -361,10 +531,10 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
     }
 
     // waveform: min/max par pixel pour meilleur rendu
-    if (mono.getNumSamples() > 0)
+    if (res.mono.getNumSamples() > 0)
     {
-        const float* x = mono.getReadPointer(0);
-        const int n = mono.getNumSamples();
+        const float* x = res.mono.getReadPointer(0);
+        const int n = res.mono.getNumSamples();
 
         g.setColour(theme.wave);
 
@@ -394,17 +564,17 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
     }
     
     // Overlay: enveloppe d'amplitude extraite
-    if (!envelope.empty())
+    if (!res.envelope.empty())
     {
         g.setColour(theme.env.withAlpha(0.6f));
         juce::Path envPath;
         
-        const int envSize = (int)envelope.size();
+        const int envSize = (int)res.envelope.size();
         for (int i = 0; i < envSize; ++i)
         {
             const float r = (float)i / (float)(envSize - 1);
             const float X = (float)area.getX() + r * (float)W;
-            const float e = envelope[i] * displayScale;
+            const float e = res.envelope[i] * displayScale;
             const float Y = (float)midY - e * ampPix;
             
             if (i == 0) envPath.startNewSubPath(X, Y);
@@ -516,9 +686,9 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
     g.setFont(juce::Font(9.0f, juce::Font::plain));
     
     // Attack
-    if (attackTimeMs > 0.0f && attackTimeMs < durationMs)
+    if (res.attackTimeMs > 0.0f && res.attackTimeMs < durationMs)
     {
-        const float X = (float)area.getX() + (attackTimeMs / (float)durationMs) * (float)W;
+        const float X = (float)area.getX() + (res.attackTimeMs / (float)durationMs) * (float)W;
         g.setColour(juce::Colour(0xff22c55e));
         g.drawLine(X, (float)area.getY(), X, (float)area.getBottom(), 1.0f);
         g.setColour(juce::Colour(0xff22c55e).brighter(0.3f));
@@ -526,22 +696,31 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
     }
     
     // Decay -6dB
-    if (decay6dBMs > attackTimeMs && decay6dBMs < durationMs)
+    if (res.decay6dBMs > res.attackTimeMs && res.decay6dBMs < durationMs)
     {
-        const float X = (float)area.getX() + (decay6dBMs / (float)durationMs) * (float)W;
+        const float X = (float)area.getX() + (res.decay6dBMs / (float)durationMs) * (float)W;
         g.setColour(juce::Colour(0xfffbbf24).withAlpha(0.7f));
         g.drawLine(X, (float)area.getY(), X, (float)area.getBottom(), 1.0f);
         g.drawText("-6", (int)X - 8, area.getY() + 16, 16, 12, juce::Justification::centred);
     }
     
     // Decay -20dB
-    if (decay20dBMs > decay6dBMs && decay20dBMs < durationMs)
+    if (res.decay20dBMs > res.decay6dBMs && res.decay20dBMs < durationMs)
     {
-        const float X = (float)area.getX() + (decay20dBMs / (float)durationMs) * (float)W;
+        const float X = (float)area.getX() + (res.decay20dBMs / (float)durationMs) * (float)W;
         g.setColour(juce::Colour(0xfff97316).withAlpha(0.7f));
         g.drawLine(X, (float)area.getY(), X, (float)area.getBottom(), 1.0f);
         g.drawText("-20", (int)X - 10, area.getY() + 30, 20, 12, juce::Justification::centred);
     }
+
+    // Decay -40dB
+    if (res.decay40dBMs > res.decay20dBMs && res.decay40dBMs < durationMs)
+    {
+        const float X = (float)area.getX() + (res.decay40dBMs / (float)durationMs) * (float)W;
+        g.setColour(juce::Colour(0xffef4444).withAlpha(0.6f));
+        g.drawLine(X, (float)area.getY(), X, (float)area.getBottom(), 1.0f);
+        g.drawText("-40", (int)X - 10, area.getY() + 44, 20, 12, juce::Justification::centred);
+    }
     
     // Curseur de lecture animé
     if (isPlayingBack)
@@ -567,11 +746,11 @@ void DrumWavePreviewComponent::paint(juce::Graphics& g)
     juce::String s;
     s << "SR: " << sampleRate << " Hz   "
       << "Durée: " << durationMs << " ms   "
-      << "Samples: " << mono.getNumSamples() << "   "
-      << "Peak: " << juce::String(peak, 3) << " (" << juce::String(db(peak), 1) << " dBFS)   "
-      << "RMS: "  << juce::String(rms,  3) << " (" << juce::String(db(rms),  1) << " dBFS)   "
-      << "Freq: " << juce::String(dominantFreqHz, 0) << " Hz   "
-      << "Attack: " << juce::String(attackTimeMs, 1) << " ms";
+      << "Samples: " << res.mono.getNumSamples() << "   "
+      << "Peak: " << juce::String(res.peak, 3) << " (" << juce::String(db(res.peak), 1) << " dBFS)   "
+      << "RMS: "  << juce::String(res.rms,  3) << " (" << juce::String(db(res.rms),  1) << " dBFS)   "
+      << "Freq: " << (res.dominantFreqHz > 0.0f ? juce::String(res.dominantFreqHz, 0) + " Hz" : juce::String("-")) << "   "
+      << "Attack: " << juce::String(res.attackTimeMs, 1) << " ms";
 
     g.drawText(s, area.getX(), area.getBottom() + 6, area.getWidth(), 14, juce::Justification::centredLeft);
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <JuceHeader.h>
+#include <atomic>
 #include <functional>
+#include <memory>
 
 // Marker vertical (en ms)
 struct WaveMarker
@@ -50,6 +52,7 @@ class DrumWavePreviewComponent : public juce::Component,
 public:
     // renderFn doit écrire un buffer mono (1 canal).
     // Tu peux capturer tes params dedans.
+    // Appelé sur le thread de rendu : ne lire que des données thread-safe (atomics).
     using RenderFn = std::function<void(juce::AudioBuffer<float>& outMono,
                                         int sampleRate,
                                         int durationMs)>;
@@ -70,21 +73,68 @@ public:
     void setSampleRate(int sr);
     void setDurationMs(int ms);
 
-    // Force un rerender offline (ex: quand params changent)
+    // Demande un rerender offline (ex: quand params changent). Non bloquant :
+    // les demandes sont fusionnées, le thread de rendu traite toujours la dernière.
     void rerender();
 
+    // Pour renderFn (thread de rendu) : true si une demande plus récente est arrivée,
+    // le rendu en cours peut s'arrêter, son résultat sera jeté.
+    bool renderCancelled() const;
+
     void paint(juce::Graphics& g) override;
     void resized() override;
 
 private:
+    // Résultat d'un rendu + analyse, construit sur le thread de rendu puis
+    // publié d'un bloc ; immuable une fois publié.
+    struct Render
+    {
+        juce::AudioBuffer<float> mono; // 1ch buffer offline
+        int sampleRate = 48000;
+        int durationMs = 400;
+        float peak = 0.0f;
+        float rms  = 0.0f;
+
+        // Analyse automatique
+        std::vector<float> envelope; // Enveloppe d'amplitude extraite
+        float attackTimeMs = 0.0f;
+        float decay6dBMs = 0.0f;
+        float decay20dBMs = 0.0f;
+        float decay40dBMs = 0.0f;
+        float effectiveDurationMs = 0.0f;
+        float dominantFreqHz = 0.0f; // 0 = pas de période détectée
+    };
+
+    // Demande de rendu : réglages figés au moment du rerender()
+    struct Job
+    {
+        juce::uint32 id = 0;
+        int sampleRate = 48000;
+        int durationMs = 400;
+        RenderFn fn;
+    };
+
+    class RenderThread : public juce::Thread
+    {
+    public:
+        explicit RenderThread(DrumWavePreviewComponent& o) : juce::Thread("DrumPreviewRender"), owner(o) {}
+        void run() override;
+
+    private:
+        DrumWavePreviewComponent& owner;
+    };
+
     void onPlayClicked();
-    void computeStats();
     void stopPlayback();
-    void extractEnvelope();
-    void analyzeSignal();
+    void renderJob(const Job& job);
+    void publish(std::shared_ptr<const Render> r);
     void updatePlaybackPosition();
     void timerCallback() override;
 
+    // Stats + enveloppe + points clés + pitch, en une passe sur le buffer
+    static void analyze(Render& r);
+    static float estimatePitchHz(const std::vector<float>& dec, int begin, float decSr);
+
     juce::AudioDeviceManager& deviceManager;
 
     // UI
@@ -102,19 +152,24 @@ private:
     int sampleRate = 48000;
     int durationMs = 400;
 
-    juce::AudioBuffer<float> mono; // 1ch buffer offline
-    float peak = 0.0f;
-    float rms  = 0.0f;
-    
-    // Analyse automatique
-    std::vector<float> envelope; // Enveloppe d'amplitude extraite
-    float attackTimeMs = 0.0f;
-    float decay6dBMs = 0.0f;
-    float decay20dBMs = 0.0f;
-    float effectiveDurationMs = 0.0f;
-    float dominantFreqHz = 0.0f;
     bool autoNormalize = true;
-    
+
+    // Rendu affiché (thread message uniquement)
+    std::shared_ptr<const Render> current;
+
+    // Échanges avec le thread de rendu : dernière demande, dernier résultat
+    juce::CriticalSection jobLock;
+    Job pendingJob;
+    bool hasPendingJob = false;
+    std::atomic<juce::uint32> latestJobId{0}; // dernière demande (thread message)
+    std::atomic<juce::uint32> activeJobId{0}; // demande en cours de rendu
+
+    juce::SpinLock resultLock;
+    std::shared_ptr<const Render> pendingResult;
+    std::atomic<bool> resultReady{false};
+
+    RenderThread renderThread{ *this };
+
     // Curseur de lecture
     std::atomic<float> playbackPositionMs{0.0f};
     bool isPlayingBack = false;
@@ -131,10 +131,10 @@ namespace DrumBoxConstants
     
     namespace Audio
     {
-        /** Taille de la queue de commandes UI -> Audio */
-        constexpr int commandQueueSize = 1024;
-        
         /** Fréquence de rafraîchissement de l'UI (Hz) */
         constexpr int uiRefreshRate = 30;
+
+        /** Rafraîchissement de l'affichage CPU (en ticks du timer UI) */
+        constexpr int cpuStatsInterval = 8;
     }
 }
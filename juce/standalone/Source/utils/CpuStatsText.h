@@ -0,0 +1,45 @@
+// DrumBox/juce/standalone/Source/utils/CpuStatsText.h
+
+#pragma once
+#include <JuceHeader.h>
+#include "drumbox_core/CpuMeter.h"
+
+/**
+ * @brief Texte de la charge CPU du moteur (lecture de Engine::cpuMeter())
+ *
+ * Affiché par MainComponent : summary() dans cpuLabel, details() dans son tooltip.
+ */
+namespace CpuStatsText
+{
+    /** Texte court : "CPU 12% (max 35%) xruns 0" */
+    inline juce::String summary(const drumbox_core::CpuMeter::Snapshot& stats)
+    {
+        return "CPU " + juce::String(100.0f * stats.load, 1) + "% (max "
+             + juce::String(100.0f * stats.worst, 0) + "%) xruns " + juce::String((juce::int64)stats.xruns);
+    }
+
+    /** Détail : répartition par étage, pic, histogramme des callbacks */
+    inline juce::String details(const drumbox_core::CpuMeter::Snapshot& stats)
+    {
+        using drumbox_core::CpuMeter;
+        juce::String text = "voices " + juce::String(100.0f * stats.stage[CpuMeter::Voices], 1)
+                          + "% / reverb " + juce::String(100.0f * stats.stage[CpuMeter::Reverb], 1)
+                          + "% / fx " + juce::String(100.0f * stats.stage[CpuMeter::Fx], 1)
+                          + "% / master " + juce::String(100.0f * stats.stage[CpuMeter::Master], 1)
+                          + "% | pic " + juce::String(100.0f * stats.peak, 1) + "%";
+
+        // Histogramme depuis le dernier reset : une ligne par tranche de 10 % non vide
+        text << "\n" << juce::String((juce::int64)stats.blocks) << " callbacks";
+        for (int b = 0; b < CpuMeter::kHistBins; ++b)
+        {
+            if (stats.histogram[b] == 0)
+                continue;
+
+            const juce::String range = (b == CpuMeter::kHistBins - 1)
+                ? juce::String(">= 100%")
+                : juce::String(b * 10) + "-" + juce::String(b * 10 + 10) + "%";
+            text << "\n  " << range << " : " << juce::String((juce::int64)stats.histogram[b]);
+        }
+        return text;
+    }
+}
@@ -0,0 +1,614 @@
+// Drumbox/tools/bench/src/main.cpp
+//
+// Micro-benchmarks des briques DSP et de l'Engine complet.
+// Sortie JSON (ns/sample) pour suivre les régressions entre versions.
+
+#include "drumbox_core/Engine.h"
+#include "drumbox_core/EngineGroup.h"
+#include "drumbox_core/drums/HiHat.h"
+#include "drumbox_core/drums/Kick.h"
+#include "drumbox_core/drums/Snare.h"
+#include "drumbox_core/drums/VoicePool.h"
+#include "drumbox_core/dsp/FreqShifter.h"
+#include "drumbox_core/dsp/FxSection.h"
+#include "drumbox_core/dsp/MasterSection.h"
+#include "drumbox_core/dsp/OnePole.h"
+#include "drumbox_core/dsp/Oversampler.h"
+#include "drumbox_core/dsp/Ott3Band.h"
+#include "drumbox_core/dsp/ReverbSchroeder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace drumbox_core;
+
+namespace {
+
+constexpr float kSr = 48000.0f;
+constexpr int kBlock = 256;
+
+struct Result
+{
+    std::string name;
+    double nsPerSample = 0.0;
+    long long samples = 0;
+};
+
+struct Bench
+{
+    std::string filter;
+    long long samplesPerRun = 1 << 18;
+    int runs = 5;
+    std::vector<Result> results;
+
+    volatile float sink = 0.0f;
+
+    // fn(n) traite n samples; on garde le meilleur run (le moins bruité)
+    void run(const std::string& name, const std::function<void(int)>& fn, int chunk = kBlock)
+    {
+        if (!filter.empty() && name.find(filter) == std::string::npos)
+            return;
+
+        using Clock = std::chrono::steady_clock;
+
+        // chauffe
+        for (long long done = 0; done < samplesPerRun / 8; done += chunk)
+            fn(chunk);
+
+        double best = 1.0e30;
+        for (int r = 0; r < runs; ++r)
+        {
+            const auto t0 = Clock::now();
+            for (long long done = 0; done < samplesPerRun; done += chunk)
+                fn(chunk);
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+            best = std::min(best, ns / (double)samplesPerRun);
+        }
+
+        results.push_back({ name, best, samplesPerRun });
+        std::fprintf(stderr, "%-48s %9.2f ns/sample\n", name.c_str(), best);
+    }
+
+    void consume(const float* x, int n)
+    {
+        float acc = 0.0f;
+        for (int i = 0; i < n; ++i)
+            acc += x[i];
+        sink = sink + acc;
+    }
+};
+
+const char* clipName(int m)
+{
+    switch (m)
+    {
+        case 1:  return "hard";
+        case 2:  return "fold";
+        default: return "tanh";
+    }
+}
+
+// Reproduit la config faite par Engine::applyParams (cutoffs au bon sample rate)
+void setupKick(Kick& k, int clipMode, int osFactor, bool layers, int lfoTarget,
+               MathMode math = MathMode::Fast)
+{
+    k.prepare(kSr);
+    k.mathMode = math;
+    k.clipMode = clipMode;
+    k.oversampleFactor = osFactor;
+
+    const float srDist = kSr * (float)osFactor;
+    k.postLP.setCutoff(k.postLpHz, srDist);
+    k.postHP.setCutoff(k.postHpHz, srDist);
+    k.tokHP.setCutoff(k.tokHpHz, srDist);
+    k.chain1LP.setCutoff(k.chain1LpHz, srDist);
+    k.chain2LP.setCutoff(k.chain2LpHz, srDist);
+
+    if (layers)
+    {
+        k.layer1Enabled = 1.0f; k.layer1Type = 1.0f; k.layer1Vol = 0.5f; k.layer1Drive = 0.3f;
+        k.layer2Enabled = 1.0f; k.layer2Type = 2.0f; k.layer2Vol = 0.4f; k.layer2Drive = 0.3f;
+    }
+
+    if (lfoTarget >= 0)
+    {
+        k.lfoAmount = 0.5f;
+        k.lfoRateHz = 4.0f;
+        k.lfoTarget = (float)lfoTarget;
+    }
+}
+
+void benchKick(Bench& b)
+{
+    std::vector<float> buf(kBlock);
+
+    auto runKick = [&](const std::string& name, Kick& k) {
+        b.run(name, [&](int n) {
+            if (!k.active)
+                k.trigger(1.0f);
+            k.processBlock(buf.data(), n);
+            b.consume(buf.data(), n);
+        });
+    };
+
+    for (int clip = 0; clip < 3; ++clip)
+        for (int os = 1; os <= 2; os *= 2)
+            for (int layers = 0; layers < 2; ++layers)
+            {
+                Kick k;
+                setupKick(k, clip, os, layers != 0, -1);
+                runKick(std::string("kick/clip=") + clipName(clip)
+                        + "/os=" + std::to_string(os) + "x"
+                        + "/layers=" + (layers ? "on" : "off"), k);
+            }
+
+    for (int os = 4; os <= 8; os *= 2)
+    {
+        Kick k;
+        setupKick(k, 0, os, false, -1);
+        runKick(std::string("kick/clip=tanh/os=") + std::to_string(os) + "x/layers=off", k);
+    }
+
+    static const char* kTargets[] = { "pitch", "drive", "cutoff", "phase" };
+    for (int t = 0; t < 4; ++t)
+    {
+        Kick k;
+        setupKick(k, 0, 1, t == 3, t);
+        runKick(std::string("kick/lfo=") + kTargets[t], k);
+    }
+
+    // backend math de référence (libm) pour comparaison
+    for (int clip = 0; clip < 3; ++clip)
+    {
+        Kick k;
+        setupKick(k, clip, 1, true, -1, MathMode::Reference);
+        runKick(std::string("kick/math=reference/clip=") + clipName(clip) + "/layers=on", k);
+    }
+    for (int t = 0; t < 4; ++t)
+    {
+        Kick k;
+        setupKick(k, 0, 1, t == 3, t, MathMode::Reference);
+        runKick(std::string("kick/math=reference/lfo=") + kTargets[t], k);
+    }
+}
+
+void benchVoices(Bench& b)
+{
+    std::vector<float> buf(kBlock);
+
+    Snare s;
+    s.prepare(kSr);
+    b.run("snare", [&](int n) {
+        if (!s.active)
+            s.trigger(1.0f);
+        s.processBlock(buf.data(), n);
+        b.consume(buf.data(), n);
+    });
+
+    // roll : un hit tous les 1024 samples, les queues se chevauchent (pool de 4)
+    VoicePool<Snare, 4> pool;
+    pool.prepare(kSr);
+    std::vector<float> tmp(kBlock);
+    int sinceHit = 1 << 30;
+    b.run("snare/pool4/roll", [&](int n) {
+        if (sinceHit >= 1024)
+        {
+            pool.trigger(1.0f);
+            sinceHit = 0;
+        }
+        pool.processBlock(buf.data(), tmp.data(), n);
+        sinceHit += n;
+        b.consume(buf.data(), n);
+    });
+
+    HiHat h;
+    h.prepare(kSr);
+    h.ampEnv.setDecay(0.9995f); // decay plus long pour mesurer la voix active
+    b.run("hihat", [&](int n) {
+        if (!h.active)
+            h.trigger(1.0f);
+        h.processBlock(buf.data(), n);
+        b.consume(buf.data(), n);
+    });
+}
+
+void fillNoise(std::vector<float>& v, u32 seed)
+{
+    Noise nz;
+    nz.seed(seed);
+    for (auto& x : v)
+        x = 0.5f * nz.white();
+}
+
+void benchFx(Bench& b)
+{
+    std::vector<float> inL(kBlock), inR(kBlock), outL(kBlock), outR(kBlock);
+    fillNoise(inL, 1);
+    fillNoise(inR, 2);
+
+    {
+        DelayArena arena;
+        arena.reserve(ReverbSchroeder::requiredFloats(kSr));
+        ReverbSchroeder rv;
+        rv.prepare(kSr, arena);
+        rv.setParams(0.5f, 0.6f, 0.5f);
+        b.run("reverb/processMono", [&](int n) {
+            for (int i = 0; i < n; ++i)
+                rv.processMono(inL[i], outL[i], outR[i]);
+            b.consume(outL.data(), n);
+        });
+        b.run("reverb/processBlock", [&](int n) {
+            rv.processBlock(inL.data(), outL.data(), outR.data(), n);
+            b.consume(outL.data(), n);
+        });
+    }
+
+    struct Stage
+    {
+        const char* name;
+        std::function<void(FxSection&)> setup;
+    };
+    const Stage stages[] = {
+        { "none",     [](FxSection&) {} },
+        { "shift",    [](FxSection& f) { f.setShiftHz(150.0f); } },
+        { "stereo",   [](FxSection& f) { f.setStereo(0.5f); } },
+        { "disperse", [](FxSection& f) { f.setDisperse(0.6f); f.setDiffusion(0.5f); } },
+        { "inflator", [](FxSection& f) { f.setInflator(0.6f, 0.5f); } },
+        { "ott",      [](FxSection& f) { f.setOtt(0.7f); } },
+        { "env",      [](FxSection& f) { f.setEnv(0.05f, 0.9999f, 0.6f); } },
+        { "tone",     [](FxSection& f) { f.setTone(0.3f); } },
+        { "all",      [](FxSection& f) {
+              f.setShiftHz(150.0f); f.setStereo(0.5f); f.setDisperse(0.6f); f.setDiffusion(0.5f);
+              f.setInflator(0.6f, 0.5f); f.setOtt(0.7f); f.setEnv(0.05f, 0.9999f, 0.6f); f.setTone(0.3f);
+          } },
+    };
+
+    for (const auto& st : stages)
+    {
+        DelayArena arena;
+        arena.reserve(FxSection::requiredFloats(kSr));
+        FxSection fx;
+        fx.prepare(kSr, arena);
+        fx.setTone(1.0f); // tone neutre sauf si l'étage le règle
+        st.setup(fx);
+
+        b.run(std::string("fx/process/") + st.name, [&](int n) {
+            fx.triggerEnv(1.0f);
+            for (int i = 0; i < n; ++i)
+                fx.process(inL[i], inR[i], outL[i], outR[i]);
+            b.consume(outL.data(), n);
+        });
+        b.run(std::string("fx/processBlock/") + st.name, [&](int n) {
+            fx.triggerEnv(1.0f);
+            fx.processBlock(inL.data(), inR.data(), outL.data(), outR.data(), n);
+            b.consume(outL.data(), n);
+        });
+    }
+
+    // Oversampler seul autour d'un tanh : par sample (comme le kick) et par bloc
+    for (int os = 2; os <= 8; os *= 2)
+    {
+        Oversampler ovs;
+        ovs.setFactor(os);
+        b.run("oversampler/" + std::to_string(os) + "x/process", [&](int n) {
+            for (int i = 0; i < n; ++i)
+                outL[i] = ovs.process(inL[i], [](float x) { return std::tanh(x * 4.0f); });
+            b.consume(outL.data(), n);
+        });
+
+        std::vector<float> up((size_t)kBlock * (size_t)os);
+        b.run("oversampler/" + std::to_string(os) + "x/block", [&](int n) {
+            ovs.upsample(inL.data(), n, up.data());
+            for (int i = 0; i < n * os; ++i)
+                up[(size_t)i] = std::tanh(up[(size_t)i] * 4.0f);
+            ovs.downsample(up.data(), n);
+            b.consume(up.data(), n);
+        });
+    }
+
+    {
+        Ott3Band ott;
+        ott.prepare(kSr);
+        ott.setParams(0.7f);
+        b.run("ott3band", [&](int n) {
+            for (int i = 0; i < n; ++i)
+                ott.process(inL[i], inR[i], outL[i], outR[i]);
+            b.consume(outL.data(), n);
+        });
+    }
+
+    {
+        FreqShifter fs;
+        fs.prepare(kSr);
+        fs.setShiftHz(150.0f);
+        b.run("freqshifter", [&](int n) {
+            for (int i = 0; i < n; ++i)
+                outL[i] = fs.process(inL[i]);
+            b.consume(outL.data(), n);
+        });
+    }
+
+    {
+        MasterSection m;
+        m.prepare(kSr);
+        m.setEqDb(3.0f, -2.0f, 1.5f);
+        b.run("master/process", [&](int n) {
+            for (int i = 0; i < n; ++i)
+                m.process(inL[i], inR[i], 0.8f, outL[i], outR[i]);
+            b.consume(outL.data(), n);
+        });
+        b.run("master/processBlock", [&](int n) {
+            m.processBlock(inL.data(), inR.data(), 0.8f, outL.data(), outR.data(), n);
+            b.consume(outL.data(), n);
+        });
+    }
+}
+
+void setupEnginePattern(Engine& e)
+{
+    for (int s = 0; s < kSteps; s += 4)
+        e.setStep(0, s, true, 1.0f);
+    e.setStep(1, 4, true, 0.9f);
+    e.setStep(1, 12, true, 0.9f);
+    for (int s = 2; s < kSteps; s += 2)
+        e.setStep(2, s, true, 0.6f);
+}
+
+void benchEngine(Bench& b)
+{
+    for (int block = 16; block <= 4096; block *= 2)
+    {
+        Engine e;
+        e.prepare(kSr, block);
+        e.setBpm(150.0f);
+        e.setPlaying(true);
+        setupEnginePattern(e);
+        e.params().set(&Params::kickReverbAmount, 0.3f);
+
+        std::vector<float> out((size_t)block * 2);
+        b.run("engine/block=" + std::to_string(block), [&](int n) {
+            e.process(out.data(), n, 2);
+            b.consume(out.data(), n);
+        }, block);
+    }
+
+    // Instance au repos (transport lancé, pattern vide, queues éteintes) : étages sautés
+    {
+        Engine e;
+        e.prepare(kSr, 256);
+        e.setBpm(150.0f);
+        e.setPlaying(true);
+        e.params().set(&Params::kickReverbAmount, 0.3f);
+
+        std::vector<float> out(256 * 2);
+        b.run("engine/idle", [&](int n) {
+            e.process(out.data(), n, 2);
+            b.consume(out.data(), n);
+        }, 256);
+    }
+
+    // Four-on-the-floor, kick seul, réglages fixes : live vs cache (lecture de buffer)
+    for (int cached = 0; cached <= 1; ++cached)
+    {
+        Engine e;
+        e.setKickCacheEnabled(cached != 0);
+        e.prepare(kSr, 256);
+        e.setBpm(150.0f);
+        e.setPlaying(true);
+        for (int s = 0; s < kSteps; s += 4)
+            e.setStep(0, s, true, 1.0f);
+
+        std::vector<float> out(256 * 2);
+        b.run(std::string("engine/kick-4x4/cache=") + (cached ? "on" : "off"), [&](int n) {
+            e.process(out.data(), n, 2);
+            b.consume(out.data(), n);
+        }, 256);
+    }
+
+    // Host planar : interleaved + désentrelacement (ancien chemin JUCE) vs processPlanar
+    for (int planar = 0; planar <= 1; ++planar)
+    {
+        Engine e;
+        e.prepare(kSr, 512);
+        e.setBpm(150.0f);
+        e.setPlaying(true);
+        setupEnginePattern(e);
+        e.params().set(&Params::kickReverbAmount, 0.3f);
+
+        std::vector<float> tmp(512 * 2), l(512), r(512);
+        float* channels[2] = { l.data(), r.data() };
+        b.run(std::string("engine/host-planar/") + (planar ? "direct" : "deinterleave"), [&](int n) {
+            if (planar)
+            {
+                e.processPlanar(channels, 2, n);
+            }
+            else
+            {
+                e.process(tmp.data(), n, 2);
+                for (int i = 0; i < n; ++i)
+                {
+                    l[i] = tmp[(size_t)i * 2];
+                    r[i] = tmp[(size_t)i * 2 + 1];
+                }
+            }
+            b.consume(l.data(), n);
+        }, 512);
+    }
+}
+
+// Queues longues : un seul coup puis du silence, sans garde FTZ/DAZ
+// (seuls les flushs des briques protègent). Le coût par sample doit rester
+// plat une fois la queue sous les niveaux normaux.
+void benchTails(Bench& b)
+{
+    std::vector<float> zero(kBlock, 0.0f), l(kBlock), r(kBlock);
+
+    {
+        OnePoleLP lp;
+        lp.setCutoff(200.0f, kSr);
+        lp.process(1.0f);
+        b.run("tail/onepole", [&](int n) {
+            for (int i = 0; i < n; ++i)
+                l[i] = lp.process(0.0f);
+            b.consume(l.data(), n);
+        });
+    }
+
+    {
+        // amp très long : pitch/drive passent des secondes au fond de leur décroissance
+        Kick k;
+        setupKick(k, 0, 1, false, -1);
+        k.ampEnv.setDecay(0.99998f);
+        k.tailEnv.setDecay(0.99998f);
+        k.trigger(1.0f);
+        b.run("tail/kick/long-decay", [&](int n) {
+            if (!k.active)
+                k.trigger(1.0f);
+            k.processBlock(l.data(), n);
+            b.consume(l.data(), n);
+        });
+    }
+
+    {
+        DelayArena arena;
+        arena.reserve(ReverbSchroeder::requiredFloats(kSr));
+        ReverbSchroeder rv;
+        rv.prepare(kSr, arena);
+        rv.setParams(0.5f, 1.0f, 0.5f);
+        std::vector<float> hit(kBlock, 0.0f);
+        hit[0] = 1.0f;
+        rv.processBlock(hit.data(), l.data(), r.data(), kBlock);
+        b.run("tail/reverb", [&](int n) {
+            rv.processBlock(zero.data(), l.data(), r.data(), n);
+            b.consume(l.data(), n);
+        });
+    }
+
+    {
+        // Engine arrêtée, un kick externe puis la queue reverb/FX
+        Engine e;
+        e.prepare(kSr, kBlock);
+        e.params().set(&Params::kickReverbAmount, 0.5f);
+        e.params().set(&Params::kickReverbSize, 1.0f);
+        e.pushEvent(0, 0, 1.0f);
+
+        std::vector<float> out((size_t)kBlock * 2);
+        b.run("tail/engine", [&](int n) {
+            e.process(out.data(), n, 2);
+            b.consume(out.data(), n);
+        });
+    }
+}
+
+// 8 instances, en série (0 worker) puis sur le pool ; ns par frame du mix complet
+void benchEngineGroup(Bench& b)
+{
+    constexpr int kEngines = 8;
+    constexpr int kGroupBlock = 256;
+    const int hw = (int)std::thread::hardware_concurrency();
+
+    std::vector<int> workerCounts{ 0 };
+    if (hw > 1)
+        workerCounts.push_back(hw - 1);
+
+    for (int workers : workerCounts)
+    {
+        EngineGroup g;
+        g.prepare(kEngines, kSr, kGroupBlock, workers);
+        for (int i = 0; i < kEngines; ++i)
+        {
+            Engine& e = g.engine(i);
+            e.setBpm(150.0f);
+            e.setPlaying(true);
+            setupEnginePattern(e);
+        }
+
+        std::vector<float> out((size_t)kGroupBlock * 2);
+        b.run("group/engines=8/workers=" + std::to_string(workers), [&](int n) {
+            g.process(out.data(), n, 2);
+            b.consume(out.data(), n);
+        }, kGroupBlock);
+    }
+}
+
+void writeJson(std::FILE* f, const Bench& b)
+{
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"sampleRate\": %d,\n", (int)kSr);
+    std::fprintf(f, "  \"samplesPerRun\": %lld,\n", b.samplesPerRun);
+    std::fprintf(f, "  \"runs\": %d,\n", b.runs);
+    std::fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < b.results.size(); ++i)
+    {
+        const auto& r = b.results[i];
+        std::fprintf(f, "    { \"name\": \"%s\", \"ns_per_sample\": %.3f, \"samples\": %lld }%s\n",
+                     r.name.c_str(), r.nsPerSample, r.samples,
+                     (i + 1 < b.results.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+}
+
+void printUsage()
+{
+    std::printf(
+        "Usage: drumbox_bench [options]\n"
+        "  -o, --out FILE     écrit le JSON dans FILE (défaut: stdout)\n"
+        "      --filter STR   ne lance que les benchs dont le nom contient STR\n"
+        "      --samples N    samples par run (défaut 262144)\n"
+        "      --runs N       nombre de runs, on garde le meilleur (défaut 5)\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Bench b;
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        const bool hasValue = (i + 1 < argc);
+        if ((a == "-o" || a == "--out") && hasValue)  outPath = argv[++i];
+        else if (a == "--filter" && hasValue)         b.filter = argv[++i];
+        else if (a == "--samples" && hasValue)        b.samplesPerRun = std::max(4096LL, std::atoll(argv[++i]));
+        else if (a == "--runs" && hasValue)           b.runs = std::max(1, std::atoi(argv[++i]));
+        else
+        {
+            printUsage();
+            return (a == "-h" || a == "--help") ? 0 : 1;
+        }
+    }
+
+    benchKick(b);
+    benchVoices(b);
+    benchFx(b);
+    benchEngine(b);
+    benchTails(b);
+    benchEngineGroup(b);
+
+    std::FILE* f = stdout;
+    if (!outPath.empty())
+    {
+        f = std::fopen(outPath.c_str(), "w");
+        if (!f)
+        {
+            std::fprintf(stderr, "Impossible d'ouvrir %s\n", outPath.c_str());
+            return 1;
+        }
+    }
+
+    writeJson(f, b);
+
+    if (f != stdout)
+        std::fclose(f);
+    return 0;
+}
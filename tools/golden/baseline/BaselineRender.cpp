@@ -0,0 +1,186 @@
+// Drumbox/tools/golden/baseline/BaselineRender.cpp
+//
+// Génère refs/baseline/*.f32 : les scènes golden rendues par le moteur d'origine
+// (commit ae192a8, avant le découpage en sous-blocs et les optimisations qui ont suivi).
+// Hors build : se compile contre le core de ce commit, pas contre le core courant.
+//
+//   git worktree add /tmp/drumbox-base ae192a8
+//   B=/tmp/drumbox-base/core/include G=tools/golden
+//   c++ -std=c++17 -O2 -I$B -I$G/include $G/baseline/BaselineRender.cpp $G/src/Compare.cpp -o baseline_render
+//   ./baseline_render tools/golden
+//
+// Mêmes conditions que drumbox_golden : 48 kHz, stéréo, 0.5 s, blocs de 512.
+// Le moteur d'origine n'a ni kickMathMode (libm seulement) ni kickOversample
+// (kickOversample2x on/off) : ces paramètres sont traduits ou ignorés.
+
+#include "Golden.h"
+
+// Le core d'origine est compilé ici même (son Engine.cpp, via l'include path) :
+// il appelle std::sinf, absent de libstdc++, d'où la déclaration avant l'include.
+#include <cmath>
+namespace std { using ::sinf; }
+
+#include "drumbox_core/Engine.h"
+#include "../src/Engine.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using drumbox_core::Engine;
+using drumbox_core::Params;
+
+namespace {
+
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int kFrames = kSampleRate / 2;
+constexpr int kBlock = 512;
+
+const char* const kScenes[] = {
+    "default", "gabber", "kick-os", "kick-layers-lfo", "fx",
+    "reverb-master", "reference-math", "kick-only", "kick-single",
+};
+
+struct Field
+{
+    const char* name;
+    std::atomic<float> Params::* field;
+};
+
+// Noms communs aux deux moteurs (ceux qu'utilisent les scènes golden)
+#define FIELD(n) { #n, &Params::n }
+const Field kFields[] = {
+    FIELD(masterGain), FIELD(masterEqLowDb), FIELD(masterEqMidDb), FIELD(masterEqHighDb),
+    FIELD(masterClipOn), FIELD(masterClipMode),
+    FIELD(kickDecay), FIELD(kickPitchDecay), FIELD(kickDriveDecay), FIELD(kickAttackFreq),
+    FIELD(kickBaseFreq), FIELD(kickDriveAmount), FIELD(kickClickGain), FIELD(kickPreHpHz),
+    FIELD(kickPostGain), FIELD(kickPostLpHz), FIELD(kickPostHpHz), FIELD(kickClipMode),
+    FIELD(kickTailDecay), FIELD(kickTailMix), FIELD(kickTailFreqMul), FIELD(kickSubMix),
+    FIELD(kickSubLpHz), FIELD(kickFeedback), FIELD(kickTokAmount), FIELD(kickTokHpHz),
+    FIELD(kickCrunchAmount),
+    FIELD(kickChain1Mix), FIELD(kickChain1DriveMul), FIELD(kickChain1LpHz), FIELD(kickChain1Asym),
+    FIELD(kickChain2Mix), FIELD(kickChain2DriveMul), FIELD(kickChain2LpHz), FIELD(kickChain2Asym),
+    FIELD(kickLayer1Enabled), FIELD(kickLayer1Type), FIELD(kickLayer1Vol),
+    FIELD(kickLayer2Enabled), FIELD(kickLayer2Type), FIELD(kickLayer2Vol),
+    FIELD(kickLfoAmount), FIELD(kickLfoRateHz), FIELD(kickLfoShape), FIELD(kickLfoTarget),
+    FIELD(kickReverbAmount), FIELD(kickReverbSize), FIELD(kickReverbTone),
+    FIELD(kickFxShiftHz), FIELD(kickFxStereo), FIELD(kickFxDiffusion), FIELD(kickFxCleanDirty),
+    FIELD(kickFxTone), FIELD(kickFxEnvVol), FIELD(kickFxDisperse), FIELD(kickFxInflator),
+    FIELD(kickFxOttAmount),
+};
+#undef FIELD
+
+std::string trim(const std::string& s)
+{
+    const auto b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos)
+        return {};
+    const auto e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+bool setParam(Engine& engine, const std::string& name, float v)
+{
+    Params& p = engine.params();
+    if (name == "kickMathMode")
+        return true; // l'original n'a que libm
+    if (name == "kickOversample")
+    {
+        p.kickOversample2x.store(v >= 1.0f ? 1.0f : 0.0f);
+        return true;
+    }
+    for (const Field& f : kFields)
+        if (name == f.name)
+        {
+            (p.*(f.field)).store(v);
+            return true;
+        }
+    return false;
+}
+
+bool loadScene(const std::string& path, Engine& engine)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    engine.clearPattern();
+    std::string line;
+    while (std::getline(in, line))
+    {
+        const auto hash = line.find('#');
+        if (hash != std::string::npos)
+            line.resize(hash);
+        line = trim(line);
+        const auto eq = line.find('=');
+        if (line.empty() || eq == std::string::npos)
+            continue;
+
+        const std::string name = trim(line.substr(0, eq));
+        const std::string value = trim(line.substr(eq + 1));
+        const int lane = name == "kick" ? 0 : name == "snare" ? 1 : name == "hat" ? 2 : -1;
+        if (lane >= 0)
+        {
+            int step = 0;
+            for (char c : value)
+            {
+                if (c == 'x' || c == 'X')
+                    engine.setStep(lane, step, true, 1.0f);
+                else if (c >= '1' && c <= '9')
+                    engine.setStep(lane, step, true, (float)(c - '0') / 10.0f);
+                else if (c != '.' && c != '-')
+                    continue;
+                ++step;
+            }
+        }
+        else if (name == "bpm")
+        {
+            engine.setBpm(std::strtof(value.c_str(), nullptr));
+        }
+        else if (!setParam(engine, name, std::strtof(value.c_str(), nullptr)))
+        {
+            std::fprintf(stderr, "%s: paramètre inconnu '%s'\n", path.c_str(), name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string dir = argc > 1 ? argv[1] : ".";
+
+    for (const char* name : kScenes)
+    {
+        Engine engine;
+        engine.prepare((double)kSampleRate, kBlock);
+        if (!loadScene(dir + "/scenes/" + name + ".txt", engine))
+            return 1;
+        engine.setPlaying(true);
+
+        drumbox_golden::Buffer out;
+        out.channels = kChannels;
+        out.sampleRate = kSampleRate;
+        out.samples.assign((size_t)kFrames * kChannels, 0.0f);
+        for (int done = 0; done < kFrames; done += kBlock)
+        {
+            const int n = kFrames - done < kBlock ? kFrames - done : kBlock;
+            engine.process(out.samples.data() + (size_t)done * kChannels, n, kChannels);
+        }
+
+        const std::string path = dir + "/refs/baseline/" + name + ".f32";
+        if (!drumbox_golden::writeRef(path, out))
+        {
+            std::fprintf(stderr, "écriture impossible : %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("ref  %-18s %s\n", name, path.c_str());
+    }
+    return 0;
+}
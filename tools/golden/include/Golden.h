@@ -0,0 +1,36 @@
+// Drumbox/tools/golden/include/Golden.h
+
+#pragma once
+#include <string>
+#include <vector>
+
+namespace drumbox_golden {
+
+// Rendu de référence : float32 interleaved + en-tête (magic, version, canaux, sample rate, frames).
+struct Buffer
+{
+    int channels = 2;
+    int sampleRate = 48000;
+    std::vector<float> samples; // frames * channels
+
+    long long frames() const { return channels > 0 ? (long long)samples.size() / channels : 0; }
+};
+
+bool readRef(const std::string& path, Buffer& buf);
+bool writeRef(const std::string& path, const Buffer& buf);
+
+// Comparaisons (a et b de même taille)
+
+// Bit à bit ; firstDiff = index du premier sample différent (-1 si identiques)
+bool bitExact(const Buffer& a, const Buffer& b, long long& firstDiff);
+
+// max |a - b|
+double maxAbsError(const Buffer& a, const Buffer& b);
+
+// Distance spectrale en dB : par canal, trames de 2048 (Hann, hop 1024), énergie en bandes
+// de tiers d'octave (20 Hz..Nyquist). RMS des écarts en dB sur les bandes audibles
+// (au-dessus de -100 dBFS dans l'une des deux), moyenne sur les trames.
+// Insensible à la phase et au détail du bruit : pour les changements non bit-exacts.
+double spectralDistanceDb(const Buffer& a, const Buffer& b);
+
+} // namespace drumbox_golden
@@ -0,0 +1,208 @@
+// Drumbox/tools/golden/src/Compare.cpp
+
+#include "Golden.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace drumbox_golden {
+
+namespace {
+
+constexpr char kMagic[4] = { 'D', 'B', 'G', 'R' };
+constexpr uint32_t kVersion = 1;
+
+// En-tête little-endian ; les samples sont écrits tels quels (hôtes little-endian)
+struct Header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t channels;
+    uint32_t sampleRate;
+    uint64_t frames;
+};
+
+constexpr int kFftSize = 2048;
+constexpr int kHop = kFftSize / 2;
+constexpr double kFloorPower = 1.0e-10; // -100 dBFS
+
+// FFT radix-2 en place (n puissance de 2)
+void fft(std::vector<std::complex<double>>& x)
+{
+    const size_t n = x.size();
+    for (size_t i = 1, j = 0; i < n; ++i)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(x[i], x[j]);
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const double a = -2.0 * 3.14159265358979323846 / (double)len;
+        const std::complex<double> wl(std::cos(a), std::sin(a));
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; ++k)
+            {
+                const std::complex<double> u = x[i + k];
+                const std::complex<double> v = x[i + k + len / 2] * w;
+                x[i + k] = u + v;
+                x[i + k + len / 2] = u - v;
+                w *= wl;
+            }
+        }
+    }
+}
+
+// Bornes (en bins) des bandes de tiers d'octave entre 20 Hz et Nyquist
+std::vector<int> bandEdges(int sampleRate)
+{
+    std::vector<int> edges;
+    const double binHz = (double)sampleRate / (double)kFftSize;
+    for (double f = 20.0; f < 0.5 * sampleRate; f *= std::pow(2.0, 1.0 / 3.0))
+    {
+        const int bin = std::max(1, (int)std::lround(f / binHz));
+        if (edges.empty() || bin > edges.back())
+            edges.push_back(bin);
+    }
+    edges.push_back(kFftSize / 2);
+    return edges;
+}
+
+// Énergie par bande d'une trame (canal ch, à partir du frame start)
+void bandPowers(const Buffer& b, int ch, long long start, const std::vector<double>& window,
+                const std::vector<int>& edges, std::vector<double>& out)
+{
+    std::vector<std::complex<double>> x((size_t)kFftSize);
+    const long long frames = b.frames();
+    for (int i = 0; i < kFftSize; ++i)
+    {
+        const long long f = start + i;
+        const double s = (f < frames) ? (double)b.samples[(size_t)f * (size_t)b.channels + (size_t)ch] : 0.0;
+        x[(size_t)i] = std::complex<double>(s * window[(size_t)i], 0.0);
+    }
+    fft(x);
+
+    // normalisé : un sinus pleine échelle ~ 0 dB dans sa bande
+    const double norm = 4.0 / ((double)kFftSize * (double)kFftSize);
+    out.assign(edges.size() - 1, 0.0);
+    for (size_t k = 0; k + 1 < edges.size(); ++k)
+        for (int bin = edges[k]; bin < edges[k + 1]; ++bin)
+            out[k] += std::norm(x[(size_t)bin]) * norm;
+}
+
+} // namespace
+
+bool readRef(const std::string& path, Buffer& buf)
+{
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    Header h{};
+    bool ok = std::fread(&h, sizeof(h), 1, f) == 1
+           && std::memcmp(h.magic, kMagic, 4) == 0
+           && h.version == kVersion && h.channels > 0;
+    if (ok)
+    {
+        buf.channels = (int)h.channels;
+        buf.sampleRate = (int)h.sampleRate;
+        buf.samples.resize((size_t)h.frames * h.channels);
+        ok = std::fread(buf.samples.data(), sizeof(float), buf.samples.size(), f) == buf.samples.size();
+    }
+    std::fclose(f);
+    return ok;
+}
+
+bool writeRef(const std::string& path, const Buffer& buf)
+{
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.channels = (uint32_t)buf.channels;
+    h.sampleRate = (uint32_t)buf.sampleRate;
+    h.frames = (uint64_t)buf.frames();
+
+    const bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1
+                 && std::fwrite(buf.samples.data(), sizeof(float), buf.samples.size(), f) == buf.samples.size();
+    return (std::fclose(f) == 0) && ok;
+}
+
+bool bitExact(const Buffer& a, const Buffer& b, long long& firstDiff)
+{
+    firstDiff = -1;
+    for (size_t i = 0; i < a.samples.size(); ++i)
+    {
+        uint32_t x, y;
+        std::memcpy(&x, &a.samples[i], 4);
+        std::memcpy(&y, &b.samples[i], 4);
+        if (x != y)
+        {
+            firstDiff = (long long)i;
+            return false;
+        }
+    }
+    return true;
+}
+
+double maxAbsError(const Buffer& a, const Buffer& b)
+{
+    double err = 0.0;
+    for (size_t i = 0; i < a.samples.size(); ++i)
+        err = std::max(err, std::fabs((double)a.samples[i] - (double)b.samples[i]));
+    return err;
+}
+
+double spectralDistanceDb(const Buffer& a, const Buffer& b)
+{
+    std::vector<double> window((size_t)kFftSize);
+    for (int i = 0; i < kFftSize; ++i)
+        window[(size_t)i] = 0.5 - 0.5 * std::cos(2.0 * 3.14159265358979323846 * i / (double)kFftSize);
+
+    const std::vector<int> edges = bandEdges(a.sampleRate);
+    std::vector<double> pa, pb;
+
+    double sum = 0.0;
+    int count = 0;
+    for (int ch = 0; ch < a.channels; ++ch)
+    {
+        for (long long start = 0; start < a.frames(); start += kHop)
+        {
+            bandPowers(a, ch, start, window, edges, pa);
+            bandPowers(b, ch, start, window, edges, pb);
+
+            double sq = 0.0;
+            int bands = 0;
+            for (size_t k = 0; k < pa.size(); ++k)
+            {
+                if (pa[k] < kFloorPower && pb[k] < kFloorPower)
+                    continue;
+                const double d = 10.0 * std::log10((pa[k] + kFloorPower) / (pb[k] + kFloorPower));
+                sq += d * d;
+                ++bands;
+            }
+
+            if (bands > 0)
+            {
+                sum += std::sqrt(sq / bands);
+                ++count;
+            }
+        }
+    }
+    return count > 0 ? sum / count : 0.0;
+}
+
+} // namespace drumbox_golden
@@ -0,0 +1,322 @@
+// Drumbox/tools/golden/src/main.cpp
+//
+// Test de non-régression audio : rend des scènes canoniques via Engine et compare
+// aux rendus de référence (refs/*.f32) ou à un autre cas rendu dans le même run.
+//
+//   drumbox_golden                 tous les cas (code retour != 0 si un cas échoue)
+//   drumbox_golden --update        régénère les références (après un changement voulu du son)
+//   drumbox_golden --exact         exige le bit-exact pour les cas en max-abs (même plateforme)
+//
+// Les cas base-* comparent au moteur d'origine (refs/baseline, figées : voir
+// baseline/BaselineRender.cpp) ; --update et --exact ne les concernent pas.
+
+#include "Golden.h"
+#include "Scene.h"
+
+#include "drumbox_core/Engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifndef DRUMBOX_GOLDEN_DIR
+#define DRUMBOX_GOLDEN_DIR "."
+#endif
+
+using namespace drumbox_golden;
+
+namespace {
+
+enum class Mode { Exact, MaxAbs, Spectral };
+
+const char* modeName(Mode m)
+{
+    switch (m)
+    {
+        case Mode::Exact:    return "exact";
+        case Mode::MaxAbs:   return "max-abs";
+        case Mode::Spectral: return "spectral";
+    }
+    return "?";
+}
+
+// Un cas = une scène + la façon de la rendre + ce à quoi on la compare.
+// against == nullptr : référence refs/<name>.f32, sinon le rendu du cas nommé (même run).
+// baseline : référence figée refs/baseline/<scene>.f32, rendue par le moteur d'origine
+// (voir baseline/BaselineRender.cpp) ; jamais réécrite par --update.
+struct Case
+{
+    const char* name;
+    const char* scene;          // scenes/<scene>.txt
+    Mode mode;
+    double budget;              // max-abs : amplitude ; spectral : dB
+    const char* against = nullptr;
+    bool irregularBlocks = false; // tailles de bloc variables (découpage en sous-blocs)
+    bool planar = false;          // Engine::processPlanar au lieu de process
+    bool kickCache = false;
+    bool baseline = false;
+};
+
+// Budgets : max-abs 1e-5 (-100 dBFS) couvre les écarts de compilation/plateforme
+// (contraction FMA, SIMD vs scalaire) ; le backend libm est moins portable.
+const Case kCases[] = {
+    { "default",          "default",          Mode::MaxAbs,   1.0e-5 },
+    { "gabber",           "gabber",           Mode::MaxAbs,   1.0e-5 },
+    { "kick-os",          "kick-os",          Mode::MaxAbs,   1.0e-5 },
+    { "kick-layers-lfo",  "kick-layers-lfo",  Mode::MaxAbs,   1.0e-5 },
+    { "fx",               "fx",               Mode::MaxAbs,   1.0e-5 },
+    { "reverb-master",    "reverb-master",    Mode::MaxAbs,   1.0e-5 },
+    { "reference-math",   "reference-math",   Mode::MaxAbs,   1.0e-4 },
+    { "kick-only",        "kick-only",        Mode::MaxAbs,   1.0e-5 },
+    { "kick-flam",        "kick-flam",        Mode::MaxAbs,   1.0e-5 },
+    // même scène, autre découpage / autre sortie : identique au sample près
+    { "irregular-blocks", "gabber",           Mode::Exact,    0.0,    "gabber", true },
+    { "planar",           "gabber",           Mode::Exact,    0.0,    "gabber", false, true },
+    // cache de kick : seul le bruit du click diffère du live
+    { "kick-cache",       "kick-only",        Mode::Spectral, 1.0,    "kick-only", false, false, true },
+    // sans click : identique au live ; une couche encore lue n'est pas réenregistrée
+    { "kick-cache-flam",  "kick-flam",        Mode::MaxAbs,   1.0e-5, "kick-flam", false, false, true },
+
+    // Moteur d'origine (ae192a8) : montre ce que la série d'optimisations a changé au son.
+    // Un kick isolé sans click reste à ~1.6e-5 (backend fast math, 1.2e-5 avec libm).
+    // Les scènes complètes divergent sample à sample (graine du bruit de click, tails
+    // gardées au retrigger par les pools de voix) : comparées en spectral. Mesuré :
+    // default/gabber 0.04 dB, reference-math 0.03, reverb-master 0.00, fx 0.30,
+    // kick-only 0.54, kick-layers-lfo 0.77 (oscillateurs PolyBLEP), kick-os 1.56
+    // (half-band IIR au lieu de l'oversampling linéaire).
+    { "base-kick-single",     "kick-single",     Mode::MaxAbs,   5.0e-5, nullptr, false, false, false, true },
+    { "base-default",         "default",         Mode::Spectral, 0.1,    nullptr, false, false, false, true },
+    { "base-gabber",          "gabber",          Mode::Spectral, 0.1,    nullptr, false, false, false, true },
+    { "base-reference-math",  "reference-math",  Mode::Spectral, 0.1,    nullptr, false, false, false, true },
+    { "base-reverb-master",   "reverb-master",   Mode::Spectral, 0.1,    nullptr, false, false, false, true },
+    { "base-fx",              "fx",              Mode::Spectral, 0.5,    nullptr, false, false, false, true },
+    { "base-kick-only",       "kick-only",       Mode::Spectral, 1.0,    nullptr, false, false, false, true },
+    { "base-kick-layers-lfo", "kick-layers-lfo", Mode::Spectral, 1.0,    nullptr, false, false, false, true },
+    { "base-kick-os",         "kick-os",         Mode::Spectral, 2.0,    nullptr, false, false, false, true },
+};
+
+constexpr int kSampleRate = 48000;
+constexpr int kChannels = 2;
+constexpr int kFrames = kSampleRate / 2; // 0.5 s : quelques steps de chaque lane à 200 bpm
+constexpr int kBlock = 512;
+constexpr int kIrregularBlocks[] = { 512, 37, 1, 256, 1024, 64, 333 };
+
+struct Options
+{
+    std::string dir = DRUMBOX_GOLDEN_DIR;
+    std::string only;
+    bool update = false;
+    bool exact = false;
+};
+
+bool render(const Case& c, const Options& opt, Buffer& out)
+{
+    drumbox_render::Scene scene;
+    if (!drumbox_render::loadScene(opt.dir + "/scenes/" + c.scene + ".txt", scene))
+        return false;
+    if (!scene.hasPattern)
+        drumbox_render::setDefaultPattern(scene);
+
+    drumbox_core::Engine engine;
+    engine.setKickCacheEnabled(c.kickCache);
+    engine.prepare((double)kSampleRate, 1024);
+    if (!drumbox_render::applyScene(scene, engine))
+    {
+        std::fprintf(stderr, "%s: paramètre inconnu dans la scène\n", c.name);
+        return false;
+    }
+    engine.setPlaying(true);
+
+    out.channels = kChannels;
+    out.sampleRate = kSampleRate;
+    out.samples.assign((size_t)kFrames * kChannels, 0.0f);
+
+    std::vector<float> l(1024), r(1024);
+    float* channels[kChannels] = { l.data(), r.data() };
+
+    int done = 0;
+    int k = 0;
+    while (done < kFrames)
+    {
+        int n = c.irregularBlocks ? kIrregularBlocks[k++ % 7] : kBlock;
+        n = (int)drumbox_render::blockToNextEvent(scene, done, std::min(n, kFrames - done));
+        drumbox_render::pushEvents(scene, engine, done);
+
+        float* dst = out.samples.data() + (size_t)done * kChannels;
+        if (c.planar)
+        {
+            engine.processPlanar(channels, kChannels, n);
+            for (int i = 0; i < n; ++i)
+            {
+                dst[2 * i] = l[(size_t)i];
+                dst[2 * i + 1] = r[(size_t)i];
+            }
+        }
+        else
+        {
+            engine.process(dst, n, kChannels);
+        }
+        done += n;
+    }
+    return true;
+}
+
+bool check(const Case& c, const Buffer& got, const Buffer& ref, const Options& opt)
+{
+    if (got.channels != ref.channels || got.samples.size() != ref.samples.size())
+    {
+        std::printf("FAIL %-20s format différent de la référence (%d ch, %lld frames)\n",
+                    c.name, ref.channels, ref.frames());
+        return false;
+    }
+
+    const Mode mode = (opt.exact && c.mode == Mode::MaxAbs && !c.baseline) ? Mode::Exact : c.mode;
+    bool pass = false;
+    char detail[128];
+
+    if (mode == Mode::Exact)
+    {
+        long long first = -1;
+        pass = bitExact(got, ref, first);
+        if (pass)
+            std::snprintf(detail, sizeof(detail), "identique");
+        else
+            std::snprintf(detail, sizeof(detail), "1er écart frame %lld (max-abs %.3g)",
+                          first / got.channels, maxAbsError(got, ref));
+    }
+    else if (mode == Mode::MaxAbs)
+    {
+        const double err = maxAbsError(got, ref);
+        pass = err <= c.budget;
+        std::snprintf(detail, sizeof(detail), "%.3g (%.1f dBFS) / budget %.3g",
+                      err, 20.0 * std::log10(std::max(err, 1.0e-12)), c.budget);
+    }
+    else
+    {
+        const double dist = spectralDistanceDb(got, ref);
+        pass = dist <= c.budget;
+        std::snprintf(detail, sizeof(detail), "%.3f dB / budget %.2f dB", dist, c.budget);
+    }
+
+    std::printf("%s %-20s %-8s %s%s%s\n", pass ? "ok  " : "FAIL", c.name, modeName(mode), detail,
+                c.against ? " vs " : "", c.against ? c.against : "");
+    return pass;
+}
+
+bool parseArgs(int argc, char** argv, Options& o)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        if (a == "--update")
+            o.update = true;
+        else if (a == "--exact")
+            o.exact = true;
+        else if (a == "--dir" && i + 1 < argc)
+            o.dir = argv[++i];
+        else if (a == "--case" && i + 1 < argc)
+            o.only = argv[++i];
+        else
+        {
+            std::fprintf(stderr,
+                "Usage: drumbox_golden [--update] [--exact] [--case NOM] [--dir DIR]\n"
+                "  --update     réécrit refs/*.f32 avec le rendu courant\n"
+                "  --exact      bit-exact au lieu de max-abs (références de la même plateforme)\n"
+                "  --case NOM   un seul cas (et ceux qu'il référence)\n"
+                "  --dir DIR    dossier contenant scenes/ et refs/ (défaut: source)\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt))
+        return 2;
+
+    std::map<std::string, Buffer> rendered;
+    int failed = 0;
+    int run = 0;
+
+    for (const Case& c : kCases)
+    {
+        if (!opt.only.empty() && opt.only != c.name)
+            continue;
+        ++run;
+
+        Buffer& got = rendered[c.name];
+        if (!render(c, opt, got))
+        {
+            std::printf("FAIL %-20s rendu impossible\n", c.name);
+            ++failed;
+            continue;
+        }
+
+        const std::string refPath = c.baseline ? opt.dir + "/refs/baseline/" + c.scene + ".f32"
+                                               : opt.dir + "/refs/" + c.name + ".f32";
+        if (opt.update && (c.against || c.baseline))
+            continue;
+        if (opt.update)
+        {
+            if (!writeRef(refPath, got))
+            {
+                std::fprintf(stderr, "écriture impossible : %s\n", refPath.c_str());
+                ++failed;
+            }
+            else
+            {
+                std::printf("ref  %-20s %s\n", c.name, refPath.c_str());
+            }
+            continue;
+        }
+
+        Buffer ref;
+        if (c.against)
+        {
+            // cas de comparaison : rendu à la demande s'il n'a pas tourné (--case)
+            auto it = rendered.find(c.against);
+            if (it == rendered.end())
+            {
+                const Case* other = nullptr;
+                for (const Case& o : kCases)
+                    if (std::strcmp(o.name, c.against) == 0)
+                        other = &o;
+                if (!other || !render(*other, opt, rendered[c.against]))
+                {
+                    std::printf("FAIL %-20s cas de comparaison '%s' introuvable\n", c.name, c.against);
+                    ++failed;
+                    continue;
+                }
+                it = rendered.find(c.against);
+            }
+            ref = it->second;
+        }
+        else if (!readRef(refPath, ref))
+        {
+            std::printf("FAIL %-20s référence absente : %s (--update pour la créer)\n", c.name, refPath.c_str());
+            ++failed;
+            continue;
+        }
+
+        if (!check(c, got, ref, opt))
+            ++failed;
+    }
+
+    if (run == 0)
+    {
+        std::fprintf(stderr, "aucun cas '%s'\n", opt.only.c_str());
+        return 2;
+    }
+
+    std::printf("%d/%d cas ok\n", run - failed, run);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+// Drumbox/tools/render/include/Scene.h
+
+#pragma once
+#include "drumbox_core/Engine.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace drumbox_render {
+
+// Une "scène" = tempo + pattern + jeu de paramètres.
+//
+// Format texte (une affectation par ligne, '#' = commentaire) :
+//   bpm   = 150
+//   kick  = x...x...x...x...     ('.'/'-' = off, 'x' = vel 1, '1'..'9' = vel 0.1..0.9)
+//   snare = ....x.......x...
+//   hat   = ..5...5...5...5.
+//   length = 32                  (steps du pattern, 1..64 ; défaut 16 ou la lane la plus longue)
+//   kickDriveAmount = 18          (nom d'un champ de drumbox_core::Params)
+//   @ 9600 kick 0.6               (événement : coup de lane au frame donné, vélocité 0..1)
+//   @ 9700 kickLayer1Enabled = 1  (événement : param modifié au frame donné)
+struct SceneEvent
+{
+    long long frame = 0;
+    int lane = -1;              // >= 0 : trigger ; sinon param
+    float value = 0.0f;         // vélocité ou valeur du param
+    std::string param;
+};
+
+struct Scene
+{
+    float bpm = 140.0f;
+    drumbox_core::Pattern pattern{};
+    bool hasPattern = false;
+    std::vector<std::pair<std::string, float>> params;
+    std::vector<SceneEvent> events; // triés par frame
+};
+
+// Pattern par défaut (four-on-the-floor) utilisé sans scène ni lane explicite.
+void setDefaultPattern(Scene& scene);
+
+// Parse "nom = valeur". Retourne false (et remplit err) si la ligne est invalide.
+bool parseAssignment(const std::string& line, Scene& scene, std::string& err);
+
+// Charge un fichier de scène. Les erreurs sont affichées sur stderr.
+bool loadScene(const std::string& path, Scene& scene);
+
+// Applique tempo, pattern et params sur l'engine (après prepare()).
+bool applyScene(const Scene& scene, drumbox_core::Engine& engine);
+
+// Taille du prochain bloc à partir de done : n, raccourci au prochain événement.
+// Les blocs sont coupés aux événements : chacun tombe au frame 0 d'un bloc.
+long long blockToNextEvent(const Scene& scene, long long done, long long n);
+
+// Pousse sur la file de commandes de l'engine les événements du frame done
+// (avant le process() du bloc qui commence à done).
+void pushEvents(const Scene& scene, drumbox_core::Engine& engine, long long done);
+
+// Affiche la liste des paramètres connus (avec valeur par défaut).
+void printParamNames();
+
+} // namespace drumbox_render
@@ -0,0 +1,23 @@
+// Drumbox/tools/render/include/WavWriter.h
+
+#pragma once
+#include <string>
+
+namespace drumbox_render {
+
+enum class WavFormat
+{
+    Float32, // IEEE float 32 bits
+    Pcm24    // PCM entier 24 bits
+};
+
+// Écrit un buffer interleaved (frames * channels) dans un fichier WAV.
+// Retourne false si le fichier ne peut pas être écrit.
+bool writeWav(const std::string& path,
+              const float* interleaved,
+              long long numFrames,
+              int numChannels,
+              int sampleRate,
+              WavFormat format);
+
+} // namespace drumbox_render
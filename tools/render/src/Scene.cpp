@@ -0,0 +1,284 @@
+// Drumbox/tools/render/src/Scene.cpp
+
+#include "Scene.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace drumbox_render {
+
+using drumbox_core::Command;
+using drumbox_core::ParamInfo;
+using drumbox_core::Params;
+using drumbox_core::findParam;
+
+namespace {
+
+std::string trim(const std::string& s)
+{
+    const auto b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos)
+        return {};
+    const auto e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+int laneFromName(const std::string& name)
+{
+    if (name == "kick")  return 0;
+    if (name == "snare") return 1;
+    if (name == "hat")   return 2;
+    return -1;
+}
+
+bool parseSteps(const std::string& text, int lane, Scene& scene, std::string& err)
+{
+    int step = 0;
+    for (char c : text)
+    {
+        if (c == ' ' || c == '|')
+            continue; // séparateurs visuels autorisés
+        if (step >= drumbox_core::kMaxSteps)
+        {
+            err = "trop de steps (max " + std::to_string(drumbox_core::kMaxSteps) + ")";
+            return false;
+        }
+
+        if (c == '.' || c == '-')
+            scene.pattern.setStep(lane, step, false, 1.0f);
+        else if (c == 'x' || c == 'X')
+            scene.pattern.setStep(lane, step, true, 1.0f);
+        else if (c >= '1' && c <= '9')
+            scene.pattern.setStep(lane, step, true, (float)(c - '0') / 10.0f);
+        else
+        {
+            err = std::string("caractère de step invalide '") + c + "'";
+            return false;
+        }
+        ++step;
+    }
+    // une lane plus longue que le pattern l'allonge (length = N pour raccourcir)
+    if (step > scene.pattern.length)
+        scene.pattern.length = step;
+    scene.hasPattern = true;
+    return true;
+}
+
+// "@ frame lane vel" ou "@ frame nom = valeur" (le '@' déjà retiré)
+bool parseEvent(const std::string& text, Scene& scene, std::string& err)
+{
+    char* end = nullptr;
+    const long long frame = std::strtoll(text.c_str(), &end, 10);
+    if (end == text.c_str() || frame < 0)
+    {
+        err = "frame d'événement invalide";
+        return false;
+    }
+
+    const std::string rest = trim(std::string(end));
+    SceneEvent ev;
+    ev.frame = frame;
+
+    const auto eq = rest.find('=');
+    const auto sp = rest.find_first_of(" \t");
+    const std::string name = trim(rest.substr(0, eq != std::string::npos ? eq : sp));
+    const std::string value = eq != std::string::npos ? trim(rest.substr(eq + 1))
+                            : sp != std::string::npos ? trim(rest.substr(sp)) : std::string();
+
+    const float v = std::strtof(value.c_str(), &end);
+    if (value.empty() || *end != '\0')
+    {
+        err = "valeur d'événement invalide '" + value + "'";
+        return false;
+    }
+
+    if (eq == std::string::npos)
+    {
+        ev.lane = laneFromName(name);
+        if (ev.lane < 0)
+        {
+            err = "lane inconnue '" + name + "'";
+            return false;
+        }
+    }
+    else if (!findParam(name.c_str()))
+    {
+        err = "paramètre inconnu '" + name + "' (voir --list-params)";
+        return false;
+    }
+
+    ev.param = name;
+    ev.value = v;
+    scene.events.push_back(ev);
+    return true;
+}
+
+} // namespace
+
+void setDefaultPattern(Scene& scene)
+{
+    scene.pattern.clear();
+    for (int s = 0; s < drumbox_core::kSteps; s += 4)
+        scene.pattern.setStep(0, s, true, 1.0f);
+    scene.pattern.setStep(1, 4, true, 0.9f);
+    scene.pattern.setStep(1, 12, true, 0.9f);
+    for (int s = 2; s < drumbox_core::kSteps; s += 4)
+        scene.pattern.setStep(2, s, true, 0.6f);
+    scene.hasPattern = true;
+}
+
+bool parseAssignment(const std::string& line, Scene& scene, std::string& err)
+{
+    const auto eq = line.find('=');
+    if (eq == std::string::npos)
+    {
+        err = "'nom = valeur' attendu";
+        return false;
+    }
+
+    const std::string name = trim(line.substr(0, eq));
+    const std::string value = trim(line.substr(eq + 1));
+    if (name.empty() || value.empty())
+    {
+        err = "nom ou valeur vide";
+        return false;
+    }
+
+    const int lane = laneFromName(name);
+    if (lane >= 0)
+    {
+        if (!scene.hasPattern)
+            scene.pattern.clear();
+        return parseSteps(value, lane, scene, err);
+    }
+
+    char* end = nullptr;
+    const float v = std::strtof(value.c_str(), &end);
+    if (end == value.c_str() || *end != '\0')
+    {
+        err = "valeur numérique invalide '" + value + "'";
+        return false;
+    }
+
+    if (name == "bpm")
+    {
+        scene.bpm = v;
+        return true;
+    }
+
+    if (name == "length")
+    {
+        if (v < 1.0f || v > (float)drumbox_core::kMaxSteps)
+        {
+            err = "length hors limites (1.." + std::to_string(drumbox_core::kMaxSteps) + ")";
+            return false;
+        }
+        if (!scene.hasPattern)
+            scene.pattern.clear();
+        scene.pattern.length = (int)v;
+        scene.hasPattern = true;
+        return true;
+    }
+
+    if (!findParam(name.c_str()))
+    {
+        err = "paramètre inconnu '" + name + "' (voir --list-params)";
+        return false;
+    }
+
+    scene.params.emplace_back(name, v);
+    return true;
+}
+
+bool loadScene(const std::string& path, Scene& scene)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir la scène %s\n", path.c_str());
+        return false;
+    }
+
+    std::string line;
+    int lineNo = 0;
+    bool ok = true;
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        const auto hash = line.find('#');
+        if (hash != std::string::npos)
+            line.erase(hash);
+        if (trim(line).empty())
+            continue;
+
+        std::string err;
+        const std::string t = trim(line);
+        const bool parsed = t[0] == '@' ? parseEvent(t.substr(1), scene, err)
+                                        : parseAssignment(line, scene, err);
+        if (!parsed)
+        {
+            std::fprintf(stderr, "%s:%d: %s\n", path.c_str(), lineNo, err.c_str());
+            ok = false;
+        }
+    }
+
+    std::stable_sort(scene.events.begin(), scene.events.end(),
+                     [](const SceneEvent& a, const SceneEvent& b) { return a.frame < b.frame; });
+    return ok;
+}
+
+bool applyScene(const Scene& scene, drumbox_core::Engine& engine)
+{
+    engine.setBpm(scene.bpm);
+
+    engine.clearPattern();
+    engine.setPatternLength(engine.getPatternIndex(), scene.pattern.length);
+    for (int l = 0; l < drumbox_core::kLanes; ++l)
+        for (int s = 0; s < scene.pattern.length; ++s)
+        {
+            const auto st = scene.pattern.getStep(l, s);
+            if (st.on)
+                engine.setStep(l, s, true, st.vel);
+        }
+
+    Params& p = engine.params();
+    for (const auto& kv : scene.params)
+    {
+        const ParamInfo* e = findParam(kv.first.c_str());
+        if (!e)
+            return false;
+        p.set(*e, kv.second);
+    }
+    return true;
+}
+
+long long blockToNextEvent(const Scene& scene, long long done, long long n)
+{
+    for (const SceneEvent& ev : scene.events)
+        if (ev.frame > done)
+            return std::min(n, ev.frame - done);
+    return n;
+}
+
+void pushEvents(const Scene& scene, drumbox_core::Engine& engine, long long done)
+{
+    for (const SceneEvent& ev : scene.events)
+    {
+        if (ev.frame != done)
+            continue;
+        if (ev.lane >= 0)
+            engine.pushCommand(Command::trigger(ev.lane, ev.value));
+        else
+            engine.pushCommand(Command::setParam(*findParam(ev.param.c_str()), ev.value));
+    }
+}
+
+void printParamNames()
+{
+    for (const ParamInfo& e : drumbox_core::kParamInfo)
+        std::printf("%-24s %g\n", e.name, (double)e.def);
+}
+
+} // namespace drumbox_render
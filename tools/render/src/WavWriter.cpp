@@ -0,0 +1,127 @@
+// Drumbox/tools/render/src/WavWriter.cpp
+
+#include "WavWriter.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace drumbox_render {
+
+namespace {
+
+void putU16(std::vector<uint8_t>& b, uint16_t v)
+{
+    b.push_back((uint8_t)(v & 0xFF));
+    b.push_back((uint8_t)(v >> 8));
+}
+
+void putU32(std::vector<uint8_t>& b, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i)
+        b.push_back((uint8_t)((v >> (8 * i)) & 0xFF));
+}
+
+void putTag(std::vector<uint8_t>& b, const char* tag)
+{
+    b.insert(b.end(), tag, tag + 4);
+}
+
+} // namespace
+
+bool writeWav(const std::string& path,
+              const float* interleaved,
+              long long numFrames,
+              int numChannels,
+              int sampleRate,
+              WavFormat format)
+{
+    const bool isFloat = (format == WavFormat::Float32);
+    const uint16_t bytesPerSample = isFloat ? 4 : 3;
+    const uint16_t blockAlign = (uint16_t)(bytesPerSample * numChannels);
+    const uint64_t dataBytes = (uint64_t)numFrames * blockAlign;
+
+    if (dataBytes > 0xFFFFFFFFull - 64)
+    {
+        std::fprintf(stderr, "WAV trop gros (> 4 Go): %s\n", path.c_str());
+        return false;
+    }
+
+    // En-tête RIFF/WAVE. Le float utilise un fmt étendu (cbSize) + chunk fact.
+    std::vector<uint8_t> h;
+    const uint32_t fmtSize = isFloat ? 18u : 16u;
+    const uint32_t factSize = isFloat ? 12u : 0u;
+    const uint32_t riffSize = 4u + (8u + fmtSize) + factSize + 8u + (uint32_t)dataBytes;
+
+    putTag(h, "RIFF");
+    putU32(h, riffSize);
+    putTag(h, "WAVE");
+
+    putTag(h, "fmt ");
+    putU32(h, fmtSize);
+    putU16(h, isFloat ? 3 : 1); // 3 = IEEE float, 1 = PCM
+    putU16(h, (uint16_t)numChannels);
+    putU32(h, (uint32_t)sampleRate);
+    putU32(h, (uint32_t)sampleRate * blockAlign);
+    putU16(h, blockAlign);
+    putU16(h, (uint16_t)(bytesPerSample * 8));
+    if (isFloat)
+    {
+        putU16(h, 0); // cbSize
+
+        putTag(h, "fact");
+        putU32(h, 4);
+        putU32(h, (uint32_t)numFrames);
+    }
+
+    putTag(h, "data");
+    putU32(h, (uint32_t)dataBytes);
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s en écriture\n", path.c_str());
+        return false;
+    }
+
+    bool ok = std::fwrite(h.data(), 1, h.size(), f) == h.size();
+
+    const uint64_t numSamples = (uint64_t)numFrames * (uint64_t)numChannels;
+    if (ok && isFloat)
+    {
+        // little-endian natif sur les cibles supportées (x86/ARM)
+        ok = std::fwrite(interleaved, sizeof(float), (size_t)numSamples, f) == numSamples;
+    }
+    else if (ok)
+    {
+        // conversion 24 bits par paquets pour limiter la mémoire
+        std::vector<uint8_t> chunk;
+        chunk.reserve(3 * 4096);
+        for (uint64_t i = 0; i < numSamples && ok; )
+        {
+            chunk.clear();
+            const uint64_t end = (numSamples - i > 4096) ? (i + 4096) : numSamples;
+            for (; i < end; ++i)
+            {
+                float x = interleaved[i];
+                if (x > 1.0f) x = 1.0f;
+                if (x < -1.0f) x = -1.0f;
+                const int32_t v = (int32_t)std::lrint((double)x * 8388607.0);
+                chunk.push_back((uint8_t)(v & 0xFF));
+                chunk.push_back((uint8_t)((v >> 8) & 0xFF));
+                chunk.push_back((uint8_t)((v >> 16) & 0xFF));
+            }
+            ok = std::fwrite(chunk.data(), 1, chunk.size(), f) == chunk.size();
+        }
+    }
+
+    if (std::fclose(f) != 0)
+        ok = false;
+
+    if (!ok)
+        std::fprintf(stderr, "Erreur d'écriture: %s\n", path.c_str());
+    return ok;
+}
+
+} // namespace drumbox_render
@@ -0,0 +1,212 @@
+// Drumbox/tools/render/src/main.cpp
+//
+// Rendu offline (plus rapide que le temps réel) d'une scène vers un WAV.
+
+#include "Scene.h"
+#include "WavWriter.h"
+
+#include "drumbox_core/Engine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace drumbox_render;
+
+namespace {
+
+struct Options
+{
+    std::string scenePath;
+    std::string outPath;
+    std::vector<std::string> sets;
+    int bars = 4;
+    int sampleRate = 48000;
+    int blockSize = 512;
+    int channels = 2;
+    float tailMs = 0.0f;
+    float bpm = -1.0f;
+    WavFormat format = WavFormat::Float32;
+};
+
+void printUsage()
+{
+    std::printf(
+        "Usage: drumbox_render -o out.wav [options]\n"
+        "  -o, --out FILE        fichier WAV de sortie (obligatoire)\n"
+        "  -s, --scene FILE      scène (pattern + params), voir Scene.h\n"
+        "  -b, --bars N          nombre de mesures à rendre (défaut 4)\n"
+        "  -r, --rate HZ         sample rate (défaut 48000)\n"
+        "      --block N         taille de bloc passée à Engine::process (défaut 512)\n"
+        "      --channels N      1 ou 2 (défaut 2)\n"
+        "      --bpm X           force le tempo\n"
+        "      --tail-ms MS      rend MS ms de queue après la dernière mesure\n"
+        "  -f, --format F        f32 (défaut) ou s24\n"
+        "      --set NOM=VAL     fixe un paramètre (répétable)\n"
+        "      --list-params     liste les paramètres connus\n");
+}
+
+bool parseArgs(int argc, char** argv, Options& o)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string a = argv[i];
+        auto next = [&](const char* what) -> const char* {
+            if (i + 1 >= argc)
+            {
+                std::fprintf(stderr, "%s attend une valeur\n", what);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        const char* v = nullptr;
+        if (a == "-h" || a == "--help")
+        {
+            printUsage();
+            std::exit(0);
+        }
+        else if (a == "--list-params")
+        {
+            printParamNames();
+            std::exit(0);
+        }
+        else if (a == "-o" || a == "--out")          { if (!(v = next("--out"))) return false; o.outPath = v; }
+        else if (a == "-s" || a == "--scene")   { if (!(v = next("--scene"))) return false; o.scenePath = v; }
+        else if (a == "-b" || a == "--bars")    { if (!(v = next("--bars"))) return false; o.bars = std::atoi(v); }
+        else if (a == "-r" || a == "--rate")    { if (!(v = next("--rate"))) return false; o.sampleRate = std::atoi(v); }
+        else if (a == "--block")                { if (!(v = next("--block"))) return false; o.blockSize = std::atoi(v); }
+        else if (a == "--channels")             { if (!(v = next("--channels"))) return false; o.channels = std::atoi(v); }
+        else if (a == "--bpm")                  { if (!(v = next("--bpm"))) return false; o.bpm = (float)std::atof(v); }
+        else if (a == "--tail-ms")              { if (!(v = next("--tail-ms"))) return false; o.tailMs = (float)std::atof(v); }
+        else if (a == "--set")                  { if (!(v = next("--set"))) return false; o.sets.emplace_back(v); }
+        else if (a == "-f" || a == "--format")
+        {
+            if (!(v = next("--format"))) return false;
+            if (std::strcmp(v, "f32") == 0)      o.format = WavFormat::Float32;
+            else if (std::strcmp(v, "s24") == 0) o.format = WavFormat::Pcm24;
+            else
+            {
+                std::fprintf(stderr, "format inconnu '%s' (f32|s24)\n", v);
+                return false;
+            }
+        }
+        else
+        {
+            std::fprintf(stderr, "option inconnue '%s'\n", a.c_str());
+            return false;
+        }
+    }
+
+    if (o.outPath.empty())
+    {
+        std::fprintf(stderr, "--out est obligatoire\n");
+        return false;
+    }
+    if (o.bars < 1 || o.sampleRate < 8000 || o.blockSize < 1 || (o.channels != 1 && o.channels != 2) || o.tailMs < 0.0f)
+    {
+        std::fprintf(stderr, "options hors limites\n");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt))
+    {
+        printUsage();
+        return 1;
+    }
+
+    Scene scene;
+    if (!opt.scenePath.empty() && !loadScene(opt.scenePath, scene))
+        return 1;
+
+    for (const auto& s : opt.sets)
+    {
+        std::string err;
+        if (!parseAssignment(s, scene, err))
+        {
+            std::fprintf(stderr, "--set %s: %s\n", s.c_str(), err.c_str());
+            return 1;
+        }
+    }
+
+    if (!scene.hasPattern)
+        setDefaultPattern(scene);
+    if (opt.bpm > 0.0f)
+        scene.bpm = opt.bpm;
+
+    drumbox_core::Engine engine;
+    engine.prepare((double)opt.sampleRate, opt.blockSize);
+    if (!applyScene(scene, engine))
+        return 1;
+    engine.setPlaying(true);
+
+    // Durée: N mesures de 16 steps (au tempo effectif, clampé par l'engine)
+    const double secondsPerStep = 60.0 / (double)engine.getBpm() / 4.0;
+    const long long barFrames = (long long)std::ceil(secondsPerStep * drumbox_core::kSteps * opt.bars * opt.sampleRate);
+    const long long tailFrames = (long long)std::ceil(opt.tailMs * 0.001 * opt.sampleRate);
+    const long long totalFrames = barFrames + tailFrames;
+
+    std::vector<float> out((size_t)totalFrames * (size_t)opt.channels, 0.0f);
+
+    using Clock = std::chrono::steady_clock;
+    double worstBlockSec = 0.0;
+    long long numBlocks = 0;
+    const auto t0 = Clock::now();
+
+    long long done = 0;
+    while (done < totalFrames)
+    {
+        // après la dernière mesure: pattern vidé pour laisser sonner les queues
+        if (done == barFrames)
+            engine.clearPattern();
+
+        long long n = std::min<long long>(opt.blockSize, totalFrames - done);
+        if (done < barFrames)
+            n = std::min(n, barFrames - done);
+        n = blockToNextEvent(scene, done, n);
+        pushEvents(scene, engine, done);
+
+        const auto b0 = Clock::now();
+        engine.process(out.data() + (size_t)done * (size_t)opt.channels, (int)n, opt.channels);
+        const double dt = std::chrono::duration<double>(Clock::now() - b0).count();
+
+        worstBlockSec = std::max(worstBlockSec, dt);
+        ++numBlocks;
+        done += n;
+    }
+
+    const double wallSec = std::chrono::duration<double>(Clock::now() - t0).count();
+    const double audioSec = (double)totalFrames / (double)opt.sampleRate;
+    const double blockSec = (double)opt.blockSize / (double)opt.sampleRate;
+
+    float peak = 0.0f;
+    for (float x : out)
+        peak = std::max(peak, std::fabs(x));
+
+    if (!writeWav(opt.outPath, out.data(), totalFrames, opt.channels, opt.sampleRate, opt.format))
+        return 1;
+
+    std::printf("%s: %lld frames, %d ch, %d Hz, %.3f s audio, peak %.2f dBFS\n",
+                opt.outPath.c_str(), totalFrames, opt.channels, opt.sampleRate, audioSec,
+                20.0 * std::log10(std::max(1.0e-9, (double)peak)));
+    std::printf("render: %.3f ms wall, realtime factor %.1fx, %.1f ns/frame\n",
+                wallSec * 1000.0,
+                wallSec > 0.0 ? audioSec / wallSec : 0.0,
+                wallSec * 1.0e9 / (double)totalFrames);
+    std::printf("blocks: %lld x %d frames, worst %.1f us (%.2f%% of block deadline)\n",
+                numBlocks, opt.blockSize, worstBlockSec * 1.0e6,
+                100.0 * worstBlockSec / blockSec);
+    return 0;
+}
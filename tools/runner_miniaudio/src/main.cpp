@@ -5,9 +5,40 @@
 #include <cstdio>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
 
 static drumbox_core::Engine gEngine;
 static std::atomic<bool> gReady{false};
+static std::atomic<bool> gQuit{false};
+static std::atomic<bool> gShowCpu{false}; // commande cpu : les lignes gênent la saisie
+
+// Charge CPU du moteur, une ligne par seconde (en % du temps du bloc)
+static void printCpuStats(const drumbox_core::CpuMeter& cpu)
+{
+    using drumbox_core::CpuMeter;
+    const CpuMeter::Snapshot s = cpu.read();
+    std::printf("cpu %5.1f%% (peak %5.1f%%, worst %5.1f%%) | voices %4.1f%% reverb %4.1f%% fx %4.1f%% master %4.1f%% | xruns %llu/%llu\n",
+                100.0f * s.load, 100.0f * s.peak, 100.0f * s.worst,
+                100.0f * s.stage[CpuMeter::Voices], 100.0f * s.stage[CpuMeter::Reverb],
+                100.0f * s.stage[CpuMeter::Fx], 100.0f * s.stage[CpuMeter::Master],
+                (unsigned long long)s.xruns, (unsigned long long)s.blocks);
+}
+
+static void printCpuHistogram(const drumbox_core::CpuMeter& cpu)
+{
+    using drumbox_core::CpuMeter;
+    const CpuMeter::Snapshot s = cpu.read();
+    std::printf("cpu load histogram (%llu callbacks):\n", (unsigned long long)s.blocks);
+    for (int b = 0; b < CpuMeter::kHistBins; ++b)
+    {
+        if (b == CpuMeter::kHistBins - 1)
+            std::printf("  >=100%%   : %llu\n", (unsigned long long)s.histogram[b]);
+        else
+            std::printf("  %3d-%3d%% : %llu\n", b * 10, b * 10 + 10, (unsigned long long)s.histogram[b]);
+    }
+}
 
 static void data_callback(ma_device* device, void* output, const void*, ma_uint32 frameCount)
 {
@@ -20,6 +51,73 @@ static void data_callback(ma_device* device, void* output, const void*, ma_uint3
     gEngine.process(out, (int)frameCount, (int)device->playback.channels);
 }
 
+static void printHelp()
+{
+    std::printf(
+        "Commands:\n"
+        "  play | stop            transport\n"
+        "  bpm X                  tempo\n"
+        "  step LANE STEP [VEL]   active un step (pattern courant)\n"
+        "  off LANE STEP          désactive un step\n"
+        "  len N                  longueur du pattern courant (1..64)\n"
+        "  pattern N              pattern suivant (à la fin du pattern en cours)\n"
+        "  trig LANE [VEL]        joue une lane tout de suite\n"
+        "  set NAME VALUE         paramètre (nom d'un champ de Params)\n"
+        "  cpu                    affiche / masque les stats CPU (1 ligne/s, off au départ)\n"
+        "  q                      quitter\n");
+}
+
+// Une ligne de stdin -> une commande moteur (appliquée au prochain callback).
+// Renvoie false pour quitter.
+static bool runCommand(const char* line)
+{
+    using drumbox_core::Command;
+
+    char name[64] = {};
+    int a = 0, b = 0;
+    float v = 1.0f;
+    bool ok = true;
+
+    if (std::sscanf(line, "%63s", name) != 1)
+        return true;
+
+    if (!std::strcmp(name, "q") || !std::strcmp(name, "quit"))
+        return false;
+    else if (!std::strcmp(name, "help"))
+        printHelp();
+    else if (!std::strcmp(name, "cpu"))
+        gShowCpu.store(!gShowCpu.load());
+    else if (!std::strcmp(name, "play") || !std::strcmp(name, "stop"))
+        ok = gEngine.pushCommand(Command::setPlaying(!std::strcmp(name, "play")));
+    else if (!std::strcmp(name, "bpm") && std::sscanf(line, "%*s %f", &v) == 1)
+        ok = gEngine.pushCommand(Command::setBpm(v));
+    else if (!std::strcmp(name, "step") && std::sscanf(line, "%*s %d %d %f", &a, &b, &v) >= 2)
+        ok = gEngine.pushCommand(Command::setStep(a, b, true, v));
+    else if (!std::strcmp(name, "off") && std::sscanf(line, "%*s %d %d", &a, &b) == 2)
+        ok = gEngine.pushCommand(Command::setStep(a, b, false));
+    else if (!std::strcmp(name, "len") && std::sscanf(line, "%*s %d", &a) == 1)
+        ok = gEngine.pushCommand(Command::setPatternLength(a));
+    else if (!std::strcmp(name, "pattern") && std::sscanf(line, "%*s %d", &a) == 1)
+        ok = gEngine.pushCommand(Command::queuePattern(a));
+    else if (!std::strcmp(name, "trig") && std::sscanf(line, "%*s %d %f", &a, &v) >= 1)
+        ok = gEngine.pushCommand(Command::trigger(a, v));
+    else if (!std::strcmp(name, "set"))
+    {
+        char param[64] = {};
+        const drumbox_core::ParamInfo* p = nullptr;
+        if (std::sscanf(line, "%*s %63s %f", param, &v) == 2 && (p = drumbox_core::findParam(param)))
+            ok = gEngine.pushCommand(Command::setParam(*p, v));
+        else
+            std::printf("set: paramètre inconnu ou valeur manquante\n");
+    }
+    else
+        std::printf("commande inconnue ('help')\n");
+
+    if (!ok)
+        std::printf("file de commandes pleine\n");
+    return true;
+}
+
 int main()
 {
     ma_device_config cfg = ma_device_config_init(ma_device_type_playback);
@@ -45,9 +143,23 @@ int main()
         return 1;
     }
 
-    std::printf("Runner started. Press Enter to quit...\n");
-    (void)getchar();
+    std::printf("Runner started. 'help' for commands, 'q' to quit.\n");
+
+    std::thread stats([] {
+        while (!gQuit.load())
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (gShowCpu.load())
+                printCpuStats(gEngine.cpuMeter());
+        }
+    });
+
+    char line[256];
+    while (std::fgets(line, sizeof(line), stdin) && runCommand(line)) {}
+    gQuit.store(true);
+    stats.join();
 
     ma_device_uninit(&device);
+    printCpuHistogram(gEngine.cpuMeter());
     return 0;
 }